@@ -273,17 +273,15 @@ static float fallback_frexpf( float x, int *iptr )
 static inline int extractf( float, cl_uint * );
 static inline int extractf( float x, cl_uint *mant )
 {
-    static float (*frexppf)(float, int*) = NULL;
-    int e;
-    
-    // verify that frexp works properly
-    if( NULL == frexppf )
+    // verify that frexp works properly, once for all threads
+    static float (*const frexppf)(float, int*) = []() -> float (*)(float, int*)
     {
+        int e;
         if( 0.5f == frexpf( HEX_FLT( +, 1, 0, -, 130 ), &e ) && e == -129 )
-            frexppf = frexpf;
-        else
-            frexppf = fallback_frexpf;
-    }
+            return frexpf;
+        return fallback_frexpf;
+    }();
+    int e;
 
     *mant = (cl_uint) (HEX_FLT( +, 1, 0, +, 32 ) * fabsf( frexppf( x, &e )));         
     return e - 1;
@@ -1976,9 +1974,7 @@ static long double reduce1l( long double x )
 
 static long double reduce1l( long double x )
 {
-    static long double unit_exp = 0; 
-    if( 0.0L == unit_exp )
-        unit_exp = scalbnl( 1.0L, LDBL_MANT_DIG);
+    static const long double unit_exp = scalbnl( 1.0L, LDBL_MANT_DIG);
 
     if( reference_fabsl(x) >= unit_exp )
     {
@@ -2451,17 +2447,15 @@ static double fallback_frexp( double x, int *iptr )
 static inline int extract( double x, cl_ulong *mant );
 static inline int extract( double x, cl_ulong *mant )
 {
-    static double (*frexpp)(double, int*) = NULL;
-    int e;
-    
-    // verify that frexp works properly
-    if( NULL == frexpp )
+    // verify that frexp works properly, once for all threads
+    static double (*const frexpp)(double, int*) = []() -> double (*)(double, int*)
     {
+        int e;
         if( 0.5 == frexp( HEX_DBL( +, 1, 0, -, 1030 ), &e ) && e == -1029 )
-            frexpp = frexp;
-        else
-            frexpp = fallback_frexp;
-    }
+            return frexp;
+        return fallback_frexp;
+    }();
+    int e;
 
     *mant = (cl_ulong) (HEX_DBL( +, 1, 0, +, 64 ) * fabs( frexpp( x, &e )));         
     return e - 1;
@@ -3132,13 +3126,8 @@ long double reference_rintl( long double x )
   // mantissa can represent more than LDBL_MANT_DIG binary digits.
   x = rintl(x);
 #else
-    static long double magic[2] = { 0.0L, 0.0L};
-    
-    if( 0.0L == magic[0] )
-    {
-        magic[0] = scalbnl(0.5L, LDBL_MANT_DIG);
-        magic[1] = scalbnl(-0.5L, LDBL_MANT_DIG);
-    }
+    static const long double magic[2] = { scalbnl(0.5L, LDBL_MANT_DIG),
+                                          scalbnl(-0.5L, LDBL_MANT_DIG) };
 
     if( reference_fabsl(x) < magic[0] && x != 0.0L )
     {
@@ -6,6 +6,8 @@ import xml.etree.ElementTree as ET
 import json
 import argparse
 import shlex
+import shutil
+import re
 
 REPORT_HEADER = """<?xml version="1.0" encoding="UTF-8"?>
 <?xml-stylesheet xmlns="http://www.w3.org/1999/xhtml" type="text/xsl" href="#stylesheet"?>
@@ -36,13 +38,13 @@ def handle_args(argv):
         '--build-system-name',
         help='The name of the build system as known by CMake, for example \'Ninja\'.',
         type=str,
-        required=True)
+        required=False)
     parser.add_argument(
         '-c',
         '--build-system-call',
         help='The call to the used build system.',
         type=str,
-        required=True)
+        required=False)
     parser.add_argument(
         '--build-only',
         help='Whether to perform only a build without any testing.',
@@ -68,7 +70,7 @@ def handle_args(argv):
         '--device',
         help='Select SYCL device to run CTS on. ECMAScript regular expression syntax can be used.',
         type=str,
-        required=True)
+        required=False)
     parser.add_argument(
         '-n',
         '--implementation-name',
@@ -83,8 +85,69 @@ def handle_args(argv):
                         help='Test the reduced feature set instead of the full feature set.',
                         required=False,
                         action='store_true')
+    parser.add_argument(
+        '--shard',
+        help='Only run shard I out of N (1-based, e.g. 2/4) of the test executables '
+        'and test cases. The results are stored in build/shard_I_of_N instead of '
+        'producing a report.',
+        type=parse_shard,
+        required=False)
+    parser.add_argument(
+        '--balance-by-history',
+        help='Test.xml or conformance_report.xml of an earlier run, used to '
+        'balance shards by the recorded test and test case durations.',
+        type=str,
+        required=False)
+    parser.add_argument(
+        '--profile-kernels',
+        help='Run the tests with profiling enabled and add the device and host '
+        'time of each test case to the report.',
+        required=False,
+        action='store_true')
+    parser.add_argument(
+        '--slowest',
+        help='Number of slowest test cases listed in the report.',
+        type=int,
+        default=20,
+        required=False)
+    parser.add_argument(
+        '--compare-report',
+        help='conformance_report.xml or Test.xml of an earlier run to compare '
+        'the category and test case durations of this run against.',
+        type=str,
+        required=False)
+    parser.add_argument(
+        '--regression-threshold',
+        help='Percentage a duration has to grow by compared to --compare-report '
+        'to be reported as a regression.',
+        type=float,
+        default=20.0,
+        required=False)
+    parser.add_argument(
+        '--regression-min-time',
+        help='Durations in seconds below which changes are not reported as '
+        'regressions, as short durations are too noisy.',
+        type=float,
+        default=1.0,
+        required=False)
+    parser.add_argument(
+        '--merge-shards',
+        help='Merge the results of shard directories produced with --shard '
+        'into a single conformance report, without building or running tests. '
+        'The build arguments are then taken from the shards.',
+        nargs='+',
+        type=str,
+        required=False)
     args = parser.parse_args(argv)
 
+    # Merging only reads the results of shards that were built and run before
+    if args.merge_shards is None:
+        for (value, option) in [(args.build_system_name, '--build-system-name'),
+                                (args.build_system_call, '--build-system-call'),
+                                (args.device, '--device')]:
+            if value is None:
+                parser.error(option + ' is required unless --merge-shards is given')
+
     full_conformance = 'OFF' if args.fast else 'ON'
     test_deprecated_features = 'OFF' if args.disable_deprecated_features else 'ON'
     full_feature_set = 'OFF' if args.reduced_feature_set else 'ON'
@@ -93,7 +156,23 @@ def handle_args(argv):
             full_conformance, test_deprecated_features, args.exclude_categories,
             args.implementation_name, args.additional_cmake_args, args.device,
             args.additional_ctest_args, args.build_only,
-            full_feature_set)
+            full_feature_set, args.shard, args.balance_by_history,
+            args.merge_shards, args.profile_kernels, args.slowest,
+            args.compare_report, args.regression_threshold,
+            args.regression_min_time)
+
+
+def parse_shard(value):
+    """
+    Parses a shard specification of the form 'I/N'.
+    """
+    match = re.fullmatch(r'(\d+)/(\d+)', value)
+    if match is None:
+        raise argparse.ArgumentTypeError("expected I/N, got '%s'" % value)
+    index, count = int(match.group(1)), int(match.group(2))
+    if count < 1 or not 1 <= index <= count:
+        raise argparse.ArgumentTypeError("invalid shard '%s'" % value)
+    return (index, count)
 
 
 def split_additional_args(additional_args):
@@ -117,7 +196,8 @@ def split_additional_args(additional_args):
 
 def generate_cmake_call(cmake_exe, build_system_name, full_conformance,
                         test_deprecated_features, exclude_categories,
-                        additional_cmake_args, device, full_feature_set):
+                        additional_cmake_args, device, full_feature_set,
+                        profile_kernels):
     """
     Generates a CMake call based on the input in a form accepted by
     subprocess.call().
@@ -130,6 +210,7 @@ def generate_cmake_call(cmake_exe, build_system_name, full_conformance,
         '-DSYCL_CTS_ENABLE_DEPRECATED_FEATURES_TESTS=' + test_deprecated_features,
         '-DSYCL_CTS_CTEST_DEVICE=' + device,
         '-DSYCL_CTS_ENABLE_FEATURE_SET_FULL=' + full_feature_set,
+        '-DSYCL_CTS_PROFILE_KERNELS=' + ('ON' if profile_kernels else 'OFF'),
         ]
     if exclude_categories is not None:
         call += ['-DSYCL_CTS_EXCLUDE_TEST_CATEGORIES=' + exclude_categories]
@@ -157,36 +238,324 @@ def subprocess_call(parameter_list):
     return subprocess.call(parameter_list)
 
 
+# CTest include file that tests/CMakeLists.txt includes if it exists. A shard
+# adds the tests running its part of the test cases of a test executable to it.
+SHARD_TESTS_FILE = 'ctest_shard_tests.cmake'
+
+# Separates the test executable from the shard in the name of a test that only
+# runs some of the test cases of the executable
+SHARD_TEST_SEPARATOR = ':'
+
+# Stores the build arguments of a shard run next to its results
+BUILD_INFO_FILE = 'build_info.json'
+
+
+def list_ctest_tests():
+    """
+    Returns the tests known to CTest in the current directory, keyed by name.
+    The fixtures that start and stop the test server are left out, as CTest
+    adds them to every run that needs them.
+    """
+    output = subprocess.check_output(['ctest', '--show-only=json-v1'])
+    tests = {}
+    for test in json.loads(output)['tests']:
+        properties = [p['name'] for p in test.get('properties', [])]
+        if 'FIXTURES_SETUP' in properties or 'FIXTURES_CLEANUP' in properties:
+            continue
+        tests[test['name']] = test
+    return tests
+
+
+def list_test_cases(test):
+    """
+    Returns the names of the Catch2 test cases of the executable run by a CTest
+    test, or an empty list if they cannot be listed. Catch2 v3 replaced
+    --list-test-names-only by the reporters' listings, the xml one of which is
+    not wrapped and keeps names with special characters intact.
+    """
+    executable = test['command'][0]
+    # With the test server, the test runs a client next to the executables
+    if os.path.splitext(os.path.basename(executable))[0] == 'cts_client':
+        executable = os.path.join(os.path.dirname(executable), test['name'])
+    try:
+        output = subprocess.check_output(
+            [executable, '--list-tests', '--reporter', 'xml']).decode('utf-8')
+        listing = ET.fromstring(output[output.index('<?xml'):])
+    except (OSError, ValueError, subprocess.CalledProcessError,
+            ET.ParseError) as error:
+        print('Warning: could not list the test cases of %s: %s' %
+              (test['name'], error))
+        return []
+    return [test_case.find('Name').text for test_case in listing.iter('TestCase')]
+
+
+def get_executable_name(test_name):
+    """
+    Returns the name of the test executable run by a test, which differs from
+    the test name for tests that only run some of its test cases.
+    """
+    return test_name.split(SHARD_TEST_SEPARATOR)[0]
+
+
+def get_test_durations(xml_file):
+    """
+    Reads the execution time of each test executable and of each of its test
+    cases from a Test.xml file or a conformance report of an earlier run.
+    Test.xml has no TestCaseTime elements, so the test case durations are read
+    from the test output instead.
+    """
+    test_xml_root = ET.parse(xml_file).getroot()
+    if test_xml_root.find('.//TestCaseTime') is None:
+        add_test_durations(test_xml_root)
+    return (read_test_durations(test_xml_root),
+            read_test_case_durations(test_xml_root))
+
+
+def read_test_durations(test_xml_root):
+    """
+    Reads the execution time of each test executable from the xml tree of a
+    Test.xml file or a conformance report. The times of the tests that each
+    run some of the test cases of an executable are added up.
+    """
+    durations = {}
+    for test in test_xml_root.iter('Test'):
+        name = test.find('Name')
+        if name is None:
+            continue
+        executable = get_executable_name(name.text)
+        for measurement in test.iter('NamedMeasurement'):
+            if measurement.attrib.get('name') == 'Execution Time':
+                durations[executable] = durations.get(executable, 0.0) + float(
+                    measurement.find('Value').text)
+    return durations
+
+
+def get_median_duration(durations):
+    known = sorted(durations)
+    return known[len(known) // 2] if known else 1.0
+
+
+def find_tests_to_split(test_names, shard_count, durations):
+    """
+    Returns the tests that take longer than half of an even share of a shard.
+    Their test cases are distributed individually, so that a single slow test
+    executable does not bound the duration of its shard. Tests without a
+    recorded duration are assumed to take the median duration.
+    """
+    if shard_count == 1:
+        return []
+    default_duration = get_median_duration(
+        durations[name] for name in test_names if name in durations)
+    test_durations = [(name, durations.get(name, default_duration))
+                      for name in test_names]
+    share = sum(duration for (_, duration) in test_durations) / shard_count
+    return sorted(name for (name, duration) in test_durations
+                  if duration > share / 2)
+
+
+def partition_tests(test_names, shard_count, durations, test_cases=None,
+                    test_case_durations=None):
+    """
+    Distributes the tests over shard_count shards so that the total recorded
+    duration of each shard is about the same. The test cases of the tests in
+    test_cases are distributed individually. Tests without a recorded
+    duration are assumed to take the median duration, and test cases without
+    one an even part of the unrecorded duration of their test. The result only
+    depends on the inputs, so every shard computes the same partition.
+
+    Each shard is a list of (test name, test cases) pairs, where test cases is
+    None if the shard runs all test cases of the test.
+    """
+    test_cases = {} if test_cases is None else test_cases
+    test_case_durations = {} if test_case_durations is None else test_case_durations
+    default_duration = get_median_duration(
+        durations[name] for name in test_names if name in durations)
+
+    # Each unit is a whole test or a single test case of a test
+    units = []
+    for name in test_names:
+        duration = durations.get(name, default_duration)
+        if name not in test_cases:
+            units.append((duration, name, ''))
+            continue
+        recorded = [test_case_durations[(name, test_case)]
+                    for test_case in test_cases[name]
+                    if (name, test_case) in test_case_durations]
+        unrecorded_count = len(test_cases[name]) - len(recorded)
+        default_case_duration = (max(duration - sum(recorded), 0.0) /
+                                 unrecorded_count if unrecorded_count else 0.0)
+        for test_case in test_cases[name]:
+            units.append((test_case_durations.get((name, test_case),
+                                                  default_case_duration),
+                          name, test_case))
+
+    shards = [{} for _ in range(shard_count)]
+    loads = [0.0] * shard_count
+    for (duration, name, test_case) in sorted(units,
+                                              key=lambda u: (-u[0], u[1], u[2])):
+        lightest = loads.index(min(loads))
+        if name in test_cases:
+            shards[lightest].setdefault(name, []).append(test_case)
+        else:
+            shards[lightest][name] = None
+        loads[lightest] += duration
+
+    partition = []
+    for shard in shards:
+        partition.append([
+            (name, None if cases is None or len(cases) == len(test_cases[name])
+             else sorted(cases)) for (name, cases) in sorted(shard.items())
+        ])
+    return partition
+
+
+def get_shard_dir(shard):
+    return 'shard_%d_of_%d' % shard
+
+
+def quote_catch2_test_case(test_case):
+    """
+    Quotes a test case name for a Catch2 input file. Catch2 ends a name at a
+    comma even in quotes, so commas are escaped along with the characters that
+    start tags and quotes or act as wildcards.
+    """
+    return '"' + re.sub(r'([\\,*\[\]"])', r'\\\1', test_case) + '"'
+
+
+def quote_cmake_argument(value):
+    """
+    Returns a CMake bracket argument holding value, which may be a list or a
+    boolean from the json listing of CTest.
+    """
+    if isinstance(value, bool):
+        value = 'ON' if value else 'OFF'
+    elif isinstance(value, list):
+        value = ';'.join(str(v) for v in value)
+    return '[==[' + str(value) + ']==]'
+
+
+def write_shard_tests(shard, shard_tests, ctest_tests):
+    """
+    Writes SHARD_TESTS_FILE, which adds a test for each test executable the
+    shard only runs some test cases of. Such a test runs the command of the
+    whole test with a Catch2 input file listing the test cases, and has the
+    same properties. Returns the names of the tests the shard runs.
+    """
+    test_case_dir = os.path.abspath(get_shard_dir(shard) + '_test_cases')
+    if os.path.isdir(test_case_dir):
+        shutil.rmtree(test_case_dir)
+
+    test_names = []
+    lines = []
+    for (name, test_cases) in shard_tests:
+        if test_cases is None:
+            test_names.append(name)
+            continue
+        if not os.path.isdir(test_case_dir):
+            os.mkdir(test_case_dir)
+        input_file = os.path.join(test_case_dir, name + '.txt')
+        with open(input_file, 'w') as f:
+            f.writelines(quote_catch2_test_case(c) + '\n' for c in test_cases)
+
+        test = ctest_tests[name]
+        shard_test_name = name + SHARD_TEST_SEPARATOR + get_shard_dir(shard)
+        test_names.append(shard_test_name)
+        command = test['command'] + ['--input-file', input_file]
+        lines.append('add_test(%s)\n' % ' '.join(
+            quote_cmake_argument(arg) for arg in [shard_test_name] + command))
+        properties = [p for p in test.get('properties', [])
+                      if not p['name'].startswith('_')]
+        if properties:
+            lines.append('set_tests_properties(%s PROPERTIES %s)\n' % (
+                quote_cmake_argument(shard_test_name), ' '.join(
+                    p['name'] + ' ' + quote_cmake_argument(p['value'])
+                    for p in properties)))
+
+    with open(SHARD_TESTS_FILE, 'w') as f:
+        f.writelines(lines)
+    return test_names
+
+
+def remove_shard_tests():
+    if os.path.isfile(SHARD_TESTS_FILE):
+        os.remove(SHARD_TESTS_FILE)
+
+
+def remove_info_files():
+    """
+    Removes the device info dumps of earlier runs, so that only the dumps of
+    the tests run now are checked and stored.
+    """
+    if not os.path.isdir('Testing'):
+        return
+    for filename in os.listdir('Testing'):
+        if filename.endswith('.info'):
+            os.remove(os.path.join('Testing', filename))
+
+
 def configure_and_run_tests(cmake_call, build_system_call, build_only,
-                            ctest_call):
+                            ctest_call, shard=None, history_file=None):
     """
     Configures the tests with cmake to produce a ninja.build file.
     Runs the generated ninja file.
-    Runs ctest, overwriting any cached results.
+    Runs ctest, overwriting any cached results. If a shard is given, only the
+    tests of that shard are run.
     """
 
     build_system_call = build_system_call.split()
 
     subprocess_call(cmake_call)
     error_code = subprocess_call(build_system_call)
-    if (not build_only):
-        error_code = subprocess_call(ctest_call)
-    return error_code
+    if build_only:
+        return error_code
+
+    remove_info_files()
+    if shard is None:
+        return subprocess_call(ctest_call)
+
+    # Only list the tests of the build, not those added by an earlier shard
+    remove_shard_tests()
+    (index, count) = shard
+    (durations, test_case_durations) = (
+        ({}, {}) if history_file is None else get_test_durations(history_file))
+    ctest_tests = list_ctest_tests()
+    test_names = sorted(ctest_tests)
+    test_cases = {}
+    for name in find_tests_to_split(test_names, count, durations):
+        names = list_test_cases(ctest_tests[name])
+        if names:
+            test_cases[name] = names
+    shard_tests = partition_tests(test_names, count, durations, test_cases,
+                                  test_case_durations)[index - 1]
+    if not shard_tests:
+        print('Shard %d/%d has no tests to run' % shard)
+        return error_code
+    try:
+        shard_test_names = write_shard_tests(shard, shard_tests, ctest_tests)
+        return subprocess_call(ctest_call + [
+            '-R', '^(' + '|'.join(re.escape(name) for name in shard_test_names) + ')$'
+        ])
+    finally:
+        remove_shard_tests()
 
 
-def collect_info_filenames():
+def collect_info_filenames(directories=None):
     """
-    Collects all the .info test result files in the Testing directory.
+    Collects all the .info test result files in the given directories, by
+    default in Testing.
     Exits the program if no result files are found.
     """
 
+    if directories is None:
+        directories = ['Testing']
     info_filenames = []
 
     # Get all the test results in Testing
-    for filename in os.listdir('Testing'):
-        filename_full = os.path.join('Testing', filename)
-        if filename.endswith('.info'):
-            info_filenames.append(filename_full)
+    for directory in directories:
+        for filename in os.listdir(directory):
+            filename_full = os.path.join(directory, filename)
+            if filename.endswith('.info'):
+                info_filenames.append(filename_full)
 
     # Exit if we didn't find any test results
     if (len(info_filenames) == 0):
@@ -214,23 +583,249 @@ def get_valid_json_info(info_filenames):
     return json.loads(reference_info)
 
 
-def get_xml_test_results():
+def get_xml_test_results_file():
     """
-    Finds the xml file output by the test and returns the rool of the xml tree.
+    Finds the xml file output by the test.
     """
     test_tag = ""
     with open(os.path.join("Testing", "TAG"), 'r') as tag_file:
         test_tag = tag_file.readline()[:-1]
 
-    test_xml_file = os.path.join("Testing", test_tag, "Test.xml")
-    test_xml_tree = ET.parse(test_xml_file)
+    return os.path.join("Testing", test_tag, "Test.xml")
+
+
+def get_xml_test_results():
+    """
+    Finds the xml file output by the test and returns the rool of the xml tree.
+    """
+    test_xml_tree = ET.parse(get_xml_test_results_file())
     return test_xml_tree.getroot()
 
 
+def store_shard_results(shard, build_info):
+    """
+    Copies the Test.xml and the device info dumps of a shard run into the
+    shard directory, to be merged later with --merge-shards. The build_info
+    the report needs is stored next to them, so that merging does not need
+    the build arguments.
+    """
+    shard_dir = get_shard_dir(shard)
+    if os.path.isdir(shard_dir):
+        shutil.rmtree(shard_dir)
+    os.mkdir(shard_dir)
+    if os.path.isfile(os.path.join("Testing", "TAG")):
+        shutil.copy(get_xml_test_results_file(), shard_dir)
+    for info_file in collect_info_filenames():
+        shutil.copy(info_file, shard_dir)
+    with open(os.path.join(shard_dir, BUILD_INFO_FILE), 'w') as f:
+        json.dump(build_info, f, indent=2)
+    print('Stored results of shard %d/%d in ' % shard +
+          os.path.abspath(shard_dir))
+
+
+def read_build_info(shard_dirs):
+    """
+    Returns the build information stored with the results of the first shard.
+    Exits the program if none of the shards has it.
+    """
+    for shard_dir in shard_dirs:
+        build_info_file = os.path.join(shard_dir, BUILD_INFO_FILE)
+        if os.path.isfile(build_info_file):
+            with open(build_info_file, 'r') as f:
+                return json.load(f)
+    print('Fatal error: no build information in the shard directories')
+    exit(-1)
+
+
+def merge_xml_test_results(shard_dirs):
+    """
+    Merges the Test.xml files of several shards into the xml tree of the
+    first one and returns its root.
+    """
+    roots = []
+    for shard_dir in shard_dirs:
+        test_xml_file = os.path.join(shard_dir, "Test.xml")
+        if not os.path.isfile(test_xml_file):
+            print('Warning: no test results in ' + shard_dir)
+            continue
+        roots.append(ET.parse(test_xml_file).getroot())
+
+    if not roots:
+        print('Fatal error: no test results to merge')
+        exit(-1)
+
+    merged_testing = roots[0].find('Testing')
+    merged_test_list = merged_testing.find('TestList')
+    elapsed_minutes = merged_testing.find('ElapsedMinutes')
+    for root in roots[1:]:
+        testing = root.find('Testing')
+        for test in testing.find('TestList'):
+            merged_test_list.append(test)
+        end_date_time = merged_testing.find('EndDateTime')
+        for test in testing.findall('Test'):
+            if end_date_time is None:
+                merged_testing.append(test)
+            else:
+                merged_testing.insert(
+                    list(merged_testing).index(end_date_time), test)
+        # Shards run concurrently, the overall run takes as long as the
+        # slowest shard
+        other_minutes = testing.find('ElapsedMinutes')
+        if elapsed_minutes is not None and other_minutes is not None:
+            elapsed_minutes.text = str(
+                max(float(elapsed_minutes.text), float(other_minutes.text)))
+    return roots[0]
+
+
+def add_kernel_profiles(test_xml_root):
+    """
+    Adds a KernelProfile element to each test for every '[kernel-profile]'
+    line its executable printed when run with --profile-kernels.
+    """
+    marker = '[kernel-profile] '
+    for test in test_xml_root.iter('Test'):
+        output = test.find('Results/Measurement/Value')
+        if output is None or not output.text:
+            continue
+        for line in output.text.splitlines():
+            if not line.startswith(marker):
+                continue
+            profile = json.loads(line[len(marker):])
+            ET.SubElement(
+                test, 'KernelProfile', {
+                    'TestCase': profile['test-case'],
+                    'Section': profile['section'],
+                    'Commands': str(profile['commands']),
+                    'UnprofiledCommands': str(profile['unprofiled-commands']),
+                    'QueuedTime': '%.3f' % (profile['queued-ns'] / 1e6),
+                    'DeviceTime': '%.3f' % (profile['device-ns'] / 1e6),
+                    'HostTime': '%.3f' % (profile['host-ns'] / 1e6)
+                })
+
+
+def add_test_durations(test_xml_root):
+    """
+    Adds a TestCaseTime element to each test for every '[test-duration]' line
+    its executable printed.
+    """
+    marker = '[test-duration] '
+    for test in test_xml_root.iter('Test'):
+        output = test.find('Results/Measurement/Value')
+        if output is None or not output.text:
+            continue
+        for line in output.text.splitlines():
+            if not line.startswith(marker):
+                continue
+            duration = json.loads(line[len(marker):])
+            ET.SubElement(test, 'TestCaseTime', {
+                'TestCase': duration['test-case'],
+                'Time': '%.3f' % duration['seconds']
+            })
+
+
+def read_test_case_durations(test_xml_root):
+    """
+    Reads the duration of each test case from the TestCaseTime elements of a
+    conformance report, keyed by test executable and test case name.
+    """
+    durations = {}
+    for test in test_xml_root.iter('Test'):
+        name = test.find('Name')
+        if name is None:
+            continue
+        for test_case in test.iter('TestCaseTime'):
+            durations[(get_executable_name(name.text),
+                       test_case.attrib['TestCase'])] = float(
+                test_case.attrib['Time'])
+    return durations
+
+
+def get_category_name(test_name):
+    """
+    Returns the test category of a test executable name.
+    """
+    return test_name[len('test_'):] if test_name.startswith('test_') else test_name
+
+
+def find_regressions(durations, previous_durations, threshold, min_time):
+    """
+    Returns (name, duration, previous duration) for every duration that grew
+    by more than threshold percent compared to the previous run, ignoring
+    durations below min_time seconds in both runs.
+    """
+    regressions = []
+    for name, duration in durations.items():
+        previous = previous_durations.get(name)
+        if previous is None or max(duration, previous) < min_time:
+            continue
+        if duration > previous * (1 + threshold / 100):
+            regressions.append((name, duration, previous))
+    return sorted(regressions, key=lambda r: r[2] - r[1])
+
+
+def add_timing_summary(test_xml_root, slowest_count, compare_report,
+                       regression_threshold, regression_min_time):
+    """
+    Adds a Timing element with the total duration of each test category, the
+    slowest test cases and, if an earlier report is given, the categories and
+    test cases whose duration regressed.
+    """
+    timing = ET.SubElement(test_xml_root, 'Timing')
+    durations = read_test_durations(test_xml_root)
+    test_case_durations = read_test_case_durations(test_xml_root)
+
+    test_case_counts = {}
+    for (test_name, _) in test_case_durations:
+        test_case_counts[test_name] = test_case_counts.get(test_name, 0) + 1
+    for test_name, duration in sorted(durations.items(),
+                                      key=lambda d: (-d[1], d[0])):
+        ET.SubElement(timing, 'Category', {
+            'Name': get_category_name(test_name),
+            'Time': '%.3f' % duration,
+            'TestCases': str(test_case_counts.get(test_name, 0))
+        })
+
+    slowest = sorted(test_case_durations.items(),
+                     key=lambda d: (-d[1], d[0]))[:slowest_count]
+    for ((test_name, test_case), duration) in slowest:
+        ET.SubElement(timing, 'Slowest', {
+            'Category': get_category_name(test_name),
+            'TestCase': test_case,
+            'Time': '%.3f' % duration
+        })
+
+    if compare_report is None:
+        return
+    previous_root = ET.parse(compare_report).getroot()
+    timing.attrib['CompareReport'] = os.path.basename(compare_report)
+    timing.attrib['RegressionThreshold'] = '%g' % regression_threshold
+    regressions = [
+        ('Category', get_category_name(test_name), duration, previous)
+        for (test_name, duration, previous) in find_regressions(
+            durations, read_test_durations(previous_root),
+            regression_threshold, regression_min_time)
+    ] + [
+        ('TestCase', get_category_name(test_name) + ': ' + test_case,
+         duration, previous)
+        for ((test_name, test_case), duration, previous) in find_regressions(
+            test_case_durations, read_test_case_durations(previous_root),
+            regression_threshold, regression_min_time)
+    ]
+    for (kind, name, duration, previous) in regressions:
+        change = '+%.1f%%' % ((duration / previous - 1) * 100)
+        print('Timing regression: %s %s took %.3f s instead of %.3f s (%s)' %
+              (kind, name, duration, previous, change))
+        ET.SubElement(timing, 'Regression', {
+            'Kind': kind,
+            'Name': name,
+            'Time': '%.3f' % duration,
+            'PreviousTime': '%.3f' % previous,
+            'Change': change
+        })
+
+
 def update_xml_attribs(info_json, implementation_name, test_xml_root,
-                       full_conformance, cmake_call, build_system_name,
-                       build_system_call, ctest_call, test_deprecated_features,
-                       full_feature_set):
+                       build_info):
     """
     Adds attributes to the root of the xml trees json required by the
     conformance report.
@@ -257,13 +852,14 @@ def update_xml_attribs(info_json, implementation_name, test_xml_root,
     test_xml_root.attrib["DeviceFP64"] = info_json['device-fp64']
 
     # Set Build Information attribs
-    test_xml_root.attrib["FullConformanceMode"] = full_conformance
-    test_xml_root.attrib["CMakeInput"] = ' '.join(cmake_call)
-    test_xml_root.attrib["BuildSystemGenerator"] = build_system_name
-    test_xml_root.attrib["BuildSystemCall"] = build_system_call
-    test_xml_root.attrib["CTestCall"] = ' '.join(ctest_call)
-    test_xml_root.attrib["TestDeprecatedFeatures"] = test_deprecated_features
-    test_xml_root.attrib["FullFeatureSet"] = full_feature_set
+    test_xml_root.attrib["FullConformanceMode"] = build_info['full-conformance']
+    test_xml_root.attrib["CMakeInput"] = ' '.join(build_info['cmake-call'])
+    test_xml_root.attrib["BuildSystemGenerator"] = build_info['build-system-name']
+    test_xml_root.attrib["BuildSystemCall"] = build_info['build-system-call']
+    test_xml_root.attrib["CTestCall"] = ' '.join(build_info['ctest-call'])
+    test_xml_root.attrib["TestDeprecatedFeatures"] = build_info[
+        'test-deprecated-features']
+    test_xml_root.attrib["FullFeatureSet"] = build_info['full-feature-set']
 
     return test_xml_root
 
@@ -274,41 +870,77 @@ def main(argv=sys.argv[1:]):
     (cmake_exe, build_system_name, build_system_call, full_conformance,
      test_deprecated_features, exclude_categories, implementation_name,
      additional_cmake_args, device, additional_ctest_args,
-     build_only, full_feature_set) = handle_args(argv)
-
-    # Generate a cmake call in a form accepted by subprocess.call()
-    cmake_call = generate_cmake_call(cmake_exe, build_system_name,
-                                     full_conformance, test_deprecated_features,
-                                     exclude_categories, additional_cmake_args,
-                                     device, full_feature_set)
-
-    # Generate a CTest call in a form accepted by subprocess.call()
-    ctest_call = generate_ctest_call(additional_ctest_args)
+     build_only, full_feature_set, shard, history_file,
+     merge_shards, profile_kernels, slowest_count, compare_report,
+     regression_threshold, regression_min_time) = handle_args(argv)
+
+    if merge_shards is None:
+        # Generate a cmake call in a form accepted by subprocess.call()
+        cmake_call = generate_cmake_call(cmake_exe, build_system_name,
+                                         full_conformance,
+                                         test_deprecated_features,
+                                         exclude_categories,
+                                         additional_cmake_args, device,
+                                         full_feature_set, profile_kernels)
+
+        # Generate a CTest call in a form accepted by subprocess.call()
+        ctest_call = generate_ctest_call(additional_ctest_args)
+
+        build_info = {
+            'cmake-call': cmake_call,
+            'build-system-name': build_system_name,
+            'build-system-call': build_system_call,
+            'ctest-call': ctest_call,
+            'full-conformance': full_conformance,
+            'test-deprecated-features': test_deprecated_features,
+            'full-feature-set': full_feature_set
+        }
+
+    # Resolve paths given relative to the invocation directory
+    if history_file is not None:
+        history_file = os.path.abspath(history_file)
+    if merge_shards is not None:
+        merge_shards = [os.path.abspath(d) for d in merge_shards]
+    if compare_report is not None:
+        compare_report = os.path.abspath(compare_report)
 
     # Make a build directory if required and enter it
     if not os.path.isdir('build'):
         os.mkdir('build')
     os.chdir('build')
 
-    # Configure the build system with cmake, run the build, and run the tests.
-    error_code = configure_and_run_tests(cmake_call, build_system_call,
-                                         build_only, ctest_call)
+    error_code = 0
+    if merge_shards is None:
+        # Configure the build system with cmake, run the build, and run the
+        # tests.
+        error_code = configure_and_run_tests(cmake_call, build_system_call,
+                                             build_only, ctest_call, shard,
+                                             history_file)
 
-    if build_only:
-        return error_code
+        if build_only:
+            return error_code
+
+        if shard is not None:
+            store_shard_results(shard, build_info)
+            return error_code
 
     # Collect the test info files, validate them and get the contents as json.
-    info_filenames = collect_info_filenames()
+    info_dirs = ['Testing'] if merge_shards is None else merge_shards
+    info_filenames = collect_info_filenames(info_dirs)
     info_json = get_valid_json_info(info_filenames)
 
     # Get the xml results and update with the necessary information.
-    result_xml_root = get_xml_test_results()
+    if merge_shards is None:
+        result_xml_root = get_xml_test_results()
+    else:
+        result_xml_root = merge_xml_test_results(merge_shards)
+        build_info = read_build_info(merge_shards)
+    add_kernel_profiles(result_xml_root)
+    add_test_durations(result_xml_root)
+    add_timing_summary(result_xml_root, slowest_count, compare_report,
+                       regression_threshold, regression_min_time)
     result_xml_root = update_xml_attribs(info_json, implementation_name,
-                                         result_xml_root, full_conformance,
-                                         cmake_call, build_system_name,
-                                         build_system_call, ctest_call,
-                                         test_deprecated_features,
-                                         full_feature_set)
+                                         result_xml_root, build_info)
 
     # Get the xml report stylesheet and add it to the results.
     stylesheet_xml_file = os.path.join("..", "tools", "stylesheet.xml")
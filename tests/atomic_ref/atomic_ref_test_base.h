@@ -140,7 +140,8 @@ class atomic_ref_test {
  public:
   using sptr = std::shared_ptr<atomic_ref_test>;
 
-  atomic_ref_test() : queue(util::get_cts_object::queue()) {
+  atomic_ref_test()
+      : queue(util::get<util::sycl_object_cache>().queue()) {
     reset_host_values();
   }
   virtual ~atomic_ref_test() = default;
@@ -307,7 +307,7 @@ void test_async_wg_copy(sycl::queue &queue, sycl_cts::util::logger &log,
         sycl::buffer<bool, 1>(result.data(),
                                   sycl::range<1>(result.size()));
 
-    queue.submit([&](sycl::handler &cgh) {
+    const auto event = queue.submit([&](sycl::handler &cgh) {
     auto accResult =
         resultBuffer.template get_access<sycl::access_mode::write>(cgh);
     auto accGlobal =
@@ -355,6 +355,7 @@ void test_async_wg_copy(sycl::queue &queue, sycl_cts::util::logger &log,
           }
         });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
   if (!result[to_integral(check::local_to_global_no_stride)]) {
     FAIL(log, instanceName + "<" + std::to_string(dim) +
@@ -413,7 +414,7 @@ void test_wait_for(sycl::queue &queue, sycl_cts::util::logger &log,
     auto resultBuffer =
         sycl::buffer<bool, 1>(&result, sycl::range<1>(1));
 
-    queue.submit([&](sycl::handler &cgh) {
+    const auto event = queue.submit([&](sycl::handler &cgh) {
     auto accResult =
         resultBuffer.template get_access<sycl::access_mode::write>(cgh);
     auto accGlobal =
@@ -457,6 +458,7 @@ void test_wait_for(sycl::queue &queue, sycl_cts::util::logger &log,
           }
         });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
   if (!result) {
     FAIL(log, instanceName + "<" + std::to_string(dim) + ">: wait_for failed");
@@ -480,7 +482,7 @@ void check_all_dims(sycl::queue &queue, sycl_cts::util::logger &log,
     action<1, actionArgsT...>{}(queue, log, std::forward<argsT>(args)...);
     action<2, actionArgsT...>{}(queue, log, std::forward<argsT>(args)...);
     action<3, actionArgsT...>{}(queue, log, std::forward<argsT>(args)...);
-    queue.wait_and_throw();
+    sycl_cts::util::traced_wait_and_throw(queue);
 }
 
 /**
@@ -0,0 +1,59 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Provides common helpers for the performance benchmark categories.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_TESTS_COMMON_BENCHMARK_H
+#define __SYCLCTS_TESTS_COMMON_BENCHMARK_H
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include "../../util/benchmark_results.h"
+#include "common.h"
+
+#include <string>
+#include <vector>
+
+namespace sycl_cts {
+namespace benchmark {
+
+/**
+ * @brief Sets the amount of work one run of the next BENCHMARK does, so that
+ *        its throughput is reported in the `--benchmark-json` output
+ */
+inline void set_work(double bytes, double items = 0) {
+  util::get<util::benchmark_results>().set_work(bytes, items);
+}
+
+/**
+ * @brief Stores a result derived from the last BENCHMARK, such as one phase
+ *        of its runs measured with event profiling, in the `--benchmark-json`
+ *        output
+ */
+inline void add_derived(const std::string& name,
+                        const std::vector<double>& samplesNs) {
+  util::get<util::benchmark_results>().add_derived(name, samplesNs);
+}
+
+/**
+ * @brief Human readable size, used in benchmark names
+ */
+inline std::string size_name(size_t bytes) {
+  const char* units[] = {"B", "KiB", "MiB", "GiB"};
+  size_t unit = 0;
+  while (unit < 3 && bytes >= 1024 && bytes % 1024 == 0) {
+    bytes /= 1024;
+    ++unit;
+  }
+  return std::to_string(bytes) + " " + units[unit];
+}
+
+}  // namespace benchmark
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_TESTS_COMMON_BENCHMARK_H
@@ -0,0 +1,91 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include "./../../util/benchmark_results.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename T>
+struct listener_argument;
+template <typename C, typename A>
+struct listener_argument<void (C::*)(A)> {
+  using type = A;
+};
+
+// BenchmarkStats is a template in some Catch2 v3 releases and a plain struct
+// in others, so take the type from the listener interface itself
+using benchmark_stats_t = listener_argument<
+    decltype(&Catch::EventListenerBase::benchmarkEnded)>::type;
+
+template <typename DurationT>
+double to_ns(const DurationT& duration) {
+  return std::chrono::duration<double, std::nano>(duration).count();
+}
+
+/**
+ * Forwards the results of all Catch2 benchmarks to
+ * sycl_cts::util::benchmark_results.
+ */
+class benchmark_listener : public Catch::EventListenerBase {
+ public:
+  using Catch::EventListenerBase::EventListenerBase;
+
+  void testRunStarting(const Catch::TestRunInfo&) override {
+    sycl_cts::util::get<sycl_cts::util::benchmark_results>().clear();
+  }
+
+  void testCaseStarting(const Catch::TestCaseInfo& info) override {
+    m_testCase = info.name;
+  }
+
+  void sectionStarting(const Catch::SectionInfo& info) override {
+    m_sections.push_back(info.name);
+  }
+
+  void sectionEnded(const Catch::SectionStats&) override {
+    m_sections.pop_back();
+  }
+
+  void benchmarkEnded(benchmark_stats_t stats) override {
+    sycl_cts::util::benchmark_record record;
+    record.testCase = m_testCase;
+    // The outermost section is the test case itself
+    for (size_t i = 1; i < m_sections.size(); ++i) {
+      if (!record.section.empty()) record.section += " / ";
+      record.section += m_sections[i];
+    }
+    record.name = stats.info.name;
+    record.meanNs = to_ns(stats.mean.point);
+    record.meanLowerNs = to_ns(stats.mean.lower_bound);
+    record.meanUpperNs = to_ns(stats.mean.upper_bound);
+    record.stdDevNs = to_ns(stats.standardDeviation.point);
+    record.samples = stats.samples.size();
+    record.iterations = stats.info.iterations;
+    sycl_cts::util::get<sycl_cts::util::benchmark_results>().add(
+        std::move(record));
+  }
+
+  void testRunEnded(const Catch::TestRunStats&) override {
+    sycl_cts::util::get<sycl_cts::util::benchmark_results>().write();
+  }
+
+ private:
+  std::string m_testCase;
+  std::vector<std::string> m_sections;
+};
+
+}  // namespace
+
+CATCH_REGISTER_LISTENER(benchmark_listener)
@@ -30,6 +30,7 @@
 #include "../../util/math_vector.h"
 #include "../../util/proxy.h"
 #include "../../util/sycl_enums.h"
+#include "../../util/sycl_object_cache.h"
 #include "../../util/test_base.h"
 
 #include "cts_async_handler.h"
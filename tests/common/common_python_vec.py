@@ -20,6 +20,7 @@
 #
 # ************************************************************************
 
+import os
 from collections import defaultdict
 from string import Template
 from itertools import product
@@ -321,6 +322,8 @@ def get_space_count(line):
 def add_spaces_to_lines(count, string):
     """Adds a number of spaces to the start of each line"""
     all_lines = string.splitlines(True)
+    if not all_lines:
+        return string
     new_string = all_lines[0]
     for i in range(1, len(all_lines)):
         new_string += ' ' * count + all_lines[i]
@@ -353,6 +356,19 @@ def get_ifdef_string(source, type_str):
         source = source.replace('$ENDIF', '')
     return source
 
+def write_file_if_changed(output_file, content):
+    """
+    Writes content to output_file unless the file already holds exactly that
+    content, so that its timestamp is kept and the build system does not
+    recompile it after a generator re-ran without changing its output.
+    """
+    if os.path.exists(output_file):
+        with open(output_file, 'r') as existing:
+            if existing.read() == content:
+                return
+    with open(output_file, 'w+') as output:
+        output.write(content)
+
 def write_source_file(test_str, func_calls, test_name, input_file, output_file,
                       type_str):
 
@@ -368,8 +384,31 @@ def write_source_file(test_str, func_calls, test_name, input_file, output_file,
 
     source = get_ifdef_string(source, type_str)
 
-    with open(output_file, 'w+') as output:
-        output.write(source)
+    write_file_if_changed(output_file, source)
+
+def write_source_files(test_funcs, func_calls, test_name, input_file,
+                       output_file, type_str, shard_count=1):
+    """Writes the lists of test functions and their calls into |shard_count|
+    sources named by shard_file_name(). Each shard gets its own test name, so
+    that the test classes of the shards do not clash."""
+    shards = split_into_shards(list(zip(test_funcs, func_calls)), shard_count,
+                               length=lambda block: len(block[0]))
+    for (index, shard) in enumerate(shards):
+        name_suffix = '' if shard_count == 1 else '_shard' + str(index)
+        write_source_file(''.join(func for (func, _) in shard),
+                          ''.join(call for (_, call) in shard),
+                          test_name + name_suffix, input_file,
+                          shard_file_name(output_file, index, shard_count),
+                          type_str)
+
+def add_shards_argument(argparser):
+    """Adds the -shards option passed by generate_cts_test() in
+    tests/CMakeLists.txt"""
+    argparser.add_argument(
+        '-shards',
+        type=int,
+        default=1,
+        help='Number of source files to split the generated tests into')
 
 def get_types():
     types = ['char', 'sycl::byte']
@@ -567,8 +606,10 @@ def substitute_swizzles_templates(type_str, size, index_subset, value_subset, co
         test_string)
     return string
 
-def gen_swizzle_test(type_str, convert_type_str, as_type_str, size):
-    string = ''
+def gen_swizzle_tests(type_str, convert_type_str, as_type_str, size):
+    """Generates the swizzle tests for the given size as a list of independent
+    source blocks"""
+    tests = []
     if size > 4:
         test_string = SwizzleData.swizzle_full_test_template.substitute(
             name=Data.vec_name_dict[size],
@@ -590,14 +631,14 @@ def gen_swizzle_test(type_str, convert_type_str, as_type_str, size):
                 swap_pairs(Data.vals_list_dict[size])),
             reverse_order_pair_vals=', '.join(
                 swap_pairs(Data.vals_list_dict[size][::-1])))
-        string += wrap_with_kernel(
+        tests.append(wrap_with_kernel(
             type_str, 'ELEM_KERNEL_' + type_str + str(size) +
             ''.join(Data.swizzle_elem_list_dict[size][:size]).replace(
                 'sycl::elem::', ''),
             'vec<' + type_str + ', ' + str(size) + '> .swizzle<' +
             ', '.join(Data.swizzle_elem_list_dict[size][:size]) + '>',
-            test_string)
-        return string
+            test_string))
+        return tests
     # size <=4
     for length in range(size, size + 1):
         for index_subset, value_subset in zip(
@@ -605,8 +646,8 @@ def gen_swizzle_test(type_str, convert_type_str, as_type_str, size):
                     Data.swizzle_xyzw_list_dict[size][:size],
                     repeat=length),
                 product(Data.vals_list_dict[size][:size], repeat=length)):
-            string += substitute_swizzles_templates(type_str, size,
-                    index_subset, value_subset, convert_type_str, as_type_str)
+            tests.append(substitute_swizzles_templates(type_str, size,
+                    index_subset, value_subset, convert_type_str, as_type_str))
 
     if size == 4:
         for length in range(size, size + 1):
@@ -616,18 +657,50 @@ def gen_swizzle_test(type_str, convert_type_str, as_type_str, size):
                         repeat=length),
                     product(
                         Data.vals_list_dict[size][:size], repeat=length)):
-                string += substitute_swizzles_templates(type_str, size,
-                        index_subset, value_subset, convert_type_str, as_type_str)
-    return string
+                tests.append(substitute_swizzles_templates(type_str, size,
+                        index_subset, value_subset, convert_type_str, as_type_str))
+    return tests
 
 
-def write_swizzle_source_file(swizzles, input_file, output_file, type_str):
+def gen_swizzle_test(type_str, convert_type_str, as_type_str, size):
+    return ''.join(gen_swizzle_tests(type_str, convert_type_str, as_type_str,
+                                     size))
+
+
+def split_into_shards(blocks, shard_count, length=len):
+    """Splits a list of source blocks into |shard_count| contiguous parts of
+    about the same source length, as given by |length|. Some parts may be
+    empty if there are fewer blocks than shards."""
+    total = sum(length(b) for b in blocks)
+    shards = [[] for _ in range(shard_count)]
+    current = 0
+    size = 0
+    for block in blocks:
+        # Move to the next shard once this one has reached its share
+        while current + 1 < shard_count and size >= total * (current + 1) / shard_count:
+            current += 1
+        shards[current].append(block)
+        size += length(block)
+    return shards
+
+
+def shard_file_name(file_name, index, shard_count):
+    """Returns the name of the given shard of a generated file. Has to match
+    the names expected by generate_cts_test() in tests/CMakeLists.txt"""
+    if shard_count == 1:
+        return file_name
+    (stem, ext) = os.path.splitext(file_name)
+    return stem + '_shard' + str(index) + ext
+
+
+def write_swizzle_source_file(swizzles, input_file, output_file, type_str,
+                              name_suffix=''):
 
     with open(input_file, 'r') as source_file:
         source = source_file.read()
 
     source = replace_string_in_source_string(source,
-                                            remove_namespaces_whitespaces(type_str),
+                                            remove_namespaces_whitespaces(type_str) + name_suffix,
                                             '$TYPE_NAME')
 
     source = replace_string_in_source_string(source, swizzles[0],
@@ -645,8 +718,7 @@ def write_swizzle_source_file(swizzles, input_file, output_file, type_str):
 
     source = get_ifdef_string(source, type_str)
 
-    with open(output_file, 'w+') as output:
-        output.write(source)
+    write_file_if_changed(output_file, source)
 
 def get_reverse_type(type_str):
     if type_str == 'char' or type_str == 'sycl::byte':
@@ -664,24 +736,30 @@ def get_reverse_type(type_str):
         reverse_type_str = type_str
     return reverse_type_str
 
-def make_swizzles_tests(type_str, input_file, output_file):
+def make_swizzles_tests(type_str, input_file, output_file, shard_count=1):
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
 
-    swizzles = [None] * 6
-
     convert_type_str = get_reverse_type(type_str)
     as_type_str = get_reverse_type(type_str)
-    swizzles[0] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 1)
-    swizzles[1] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 2)
-    swizzles[2] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 3)
-    swizzles[3] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 4)
-    swizzles[4] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 8)
-    swizzles[5] = gen_swizzle_test(type_str, convert_type_str,
-                                   as_type_str, 16)
-    write_swizzle_source_file(swizzles, input_file, output_file, type_str)
+
+    # Keep track of the size each test belongs to, so that every shard can
+    # place its tests in the matching section of the template
+    sizes = [1, 2, 3, 4, 8, 16]
+    blocks = []
+    for (size_index, size) in enumerate(sizes):
+        for test in gen_swizzle_tests(type_str, convert_type_str, as_type_str,
+                                      size):
+            blocks.append((size_index, test))
+
+    shards = split_into_shards(blocks, shard_count,
+                               length=lambda block: len(block[1]))
+    for (index, shard) in enumerate(shards):
+        swizzles = [''] * len(sizes)
+        for (size_index, test) in shard:
+            swizzles[size_index] += test
+        name_suffix = '' if shard_count == 1 else '_shard' + str(index)
+        write_swizzle_source_file(swizzles, input_file,
+                                  shard_file_name(output_file, index,
+                                                  shard_count),
+                                  type_str, name_suffix)
@@ -0,0 +1,84 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Command line options shared by the test executables and cts_server
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include "cts_cli.h"
+
+#include "./../../util/benchmark_results.h"
+#include "./../../util/kernel_prebuilder.h"
+#include "./../../util/kernel_profiler.h"
+#include "./../../util/math_sweep.h"
+#include "./../../util/trace_recorder.h"
+
+#include <iostream>
+
+namespace sycl_cts {
+
+cli_options::cli_options() {
+  const auto& mathSweep = util::get<util::math_sweep_config>();
+  mathSeed = mathSweep.seed();
+  mathSamples = mathSweep.samples();
+}
+
+Catch::Clara::Parser make_cli(cli_options& options,
+                              const Catch::Clara::Parser& catchCli) {
+  using namespace Catch::Clara;
+
+  // TODO: Look into removing some of Catch2's default options
+  //       that we don't need. The benchmarking options are used by the
+  //       performance categories.
+  return Opt(options.devicePattern, "pattern")["--device"](
+             "Select SYCL device to run CTS on. ECMAScript "
+             "regular expression syntax can be used") |
+         Opt(options.listDevices)["--list-devices"](
+             "List all available devices") |
+         Opt(options.infoDumpFile, "file")["--info-dump"](
+             "Dump platform and device info to file") |
+         Opt(options.jobs, "N")["--jobs"](
+             "Run test cases on N worker processes. Test cases tagged "
+             "[serial] run after all others") |
+         Opt(options.benchmarkJsonFile, "file")["--benchmark-json"](
+             "Write the results of all benchmarks to file as JSON") |
+         Opt(options.profileKernels)["--profile-kernels"](
+             "Enable profiling on CTS queues and print the device and "
+             "host time of each test case and section") |
+         Opt(options.testDurations)["--test-durations"](
+             "Print the wall time of each test case after the run") |
+         Opt(options.traceFile, "file")["--trace"](
+             "Write a timeline of test cases, sections, commands and "
+             "host waits to file in the Chrome trace event format") |
+         Opt(options.prebuildThreads, "threads")["--prebuild-kernels"](
+             "Build all kernels on this many threads before running the "
+             "tests, 0 uses one thread per hardware thread") |
+         Opt(options.workerTestsFile, "file")["--worker-tests"].hidden() |
+         Opt(options.mathSeed, "seed")["--math-seed"](
+             "Seed for the randomized inputs of math builtin sweeps") |
+         Opt(options.mathSamples, "N")["--math-samples"](
+             "Number of randomized inputs each math builtin sweep checks") |
+         catchCli;
+}
+
+void apply_cli_options(const cli_options& options) {
+  util::get<util::benchmark_results>().set_output_file(
+      options.benchmarkJsonFile);
+  util::get<util::kernel_profiler>().set_enabled(options.profileKernels);
+  util::get<cts_cli>().set_test_durations(options.testDurations);
+  util::get<util::trace_recorder>().set_output_file(options.traceFile);
+  auto& mathSweep = util::get<util::math_sweep_config>();
+  mathSweep.set_seed(options.mathSeed);
+  mathSweep.set_samples(options.mathSamples);
+}
+
+void prebuild_kernels(const cli_options& options) {
+  if (options.prebuildThreads < 0) return;
+  util::get<util::kernel_prebuilder>().prebuild(
+      static_cast<unsigned>(options.prebuildThreads), std::cerr);
+}
+
+}  // namespace sycl_cts
@@ -0,0 +1,82 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Command line options shared by the test executables and cts_server
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_TESTS_COMMON_CTS_CLI_H
+#define __SYCLCTS_TESTS_COMMON_CTS_CLI_H
+
+#include <catch2/internal/catch_clara.hpp>
+
+#include "./../../util/singleton.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sycl_cts {
+
+/**
+ * Values of the CTS specific command line options
+ */
+struct cli_options {
+  std::string devicePattern;
+  std::string infoDumpFile;
+  bool listDevices = false;
+  int jobs = 1;
+  std::string benchmarkJsonFile;
+  bool profileKernels = false;
+  bool testDurations = false;
+  std::string traceFile;
+  int prebuildThreads = -1;
+  std::string workerTestsFile;
+  uint32_t mathSeed;
+  size_t mathSamples;
+
+  /** Takes the defaults of the math sweep options from math_sweep_config */
+  cli_options();
+};
+
+/**
+ * Returns catchCli extended by the CTS options, which are parsed into options
+ */
+Catch::Clara::Parser make_cli(cli_options& options,
+                              const Catch::Clara::Parser& catchCli);
+
+/**
+ * Passes the options that configure the CTS utilities on to them
+ */
+void apply_cli_options(const cli_options& options);
+
+/**
+ * CTS options that are read after the command line was parsed by code that
+ * cannot be passed cli_options, like the Catch2 listeners
+ */
+class cts_cli : public util::singleton<cts_cli> {
+ public:
+  void set_test_durations(bool enabled) { m_testDurations = enabled; }
+
+  /**
+   * Whether `--test-durations` was passed, which makes test_duration_listener
+   * print the duration of each test case
+   */
+  bool test_durations() const { return m_testDurations; }
+
+ private:
+  bool m_testDurations = false;
+};
+
+/**
+ * Builds all kernels of the executable if requested with
+ * `--prebuild-kernels`, to be called right before the session runs
+ */
+void prebuild_kernels(const cli_options& options);
+
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_TESTS_COMMON_CTS_CLI_H
@@ -0,0 +1,126 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Thin client running the test cases of a category on cts_server
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include "test_server_protocol.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::cerr << "usage: cts_client --socket <path> [--servers <count>] "
+               "<category> [arguments...]\n"
+               "       cts_client --socket <path> --shutdown\n";
+}
+
+/**
+ * Claims one of the count servers of the pool at basePath by locking its lock
+ * file, preferring a server no other client uses. The lock is released when
+ * the client exits.
+ * @return Socket path of the claimed server, empty on failure
+ */
+std::string claim_pool_server(const std::string& basePath, int count) {
+  using sycl_cts::test_server::get_pool_socket;
+  std::vector<int> lockFds;
+  for (int i = 0; i < count; ++i) {
+    const std::string lockPath = get_pool_socket(basePath, i) + ".lock";
+    const int fd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+      std::perror("cts_client");
+      return {};
+    }
+    if (::flock(fd, LOCK_EX | LOCK_NB) == 0) {
+      return get_pool_socket(basePath, i);
+    }
+    lockFds.push_back(fd);
+  }
+  // All servers are busy, wait for one of them
+  const int index = static_cast<int>(::getpid() % count);
+  while (::flock(lockFds[index], LOCK_EX) != 0) {
+    if (errno != EINTR) {
+      std::perror("cts_client");
+      return {};
+    }
+  }
+  return get_pool_socket(basePath, index);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace sycl_cts::test_server;
+
+  if (argc < 4 || std::string(argv[1]) != "--socket") {
+    print_usage();
+    return EXIT_FAILURE;
+  }
+  std::string socketPath = argv[2];
+  int firstArg = 3;
+  if (std::string(argv[3]) == "--servers") {
+    int serverCount = 0;
+    if (argc < 6 || !parse_decimal(argv[4], serverCount) ||
+        serverCount < 1) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+    socketPath = claim_pool_server(socketPath, serverCount);
+    if (socketPath.empty()) return EXIT_FAILURE;
+    firstArg = 5;
+  }
+
+  std::vector<std::string> request;
+  if (std::string(argv[firstArg]) == "--shutdown") {
+    request.push_back(shutdown_command);
+  } else {
+    request.push_back(run_command);
+    for (int i = firstArg; i < argc; ++i) request.push_back(argv[i]);
+  }
+
+  const int fd = connect_to_server(socketPath);
+  if (fd < 0) {
+    std::cerr << "cts_client: cannot connect to cts_server at " << socketPath
+              << '\n';
+    return EXIT_FAILURE;
+  }
+  std::fflush(stdout);
+  if (!send_request(fd, request) ||
+      !send_output_fds(fd, STDOUT_FILENO, STDERR_FILENO)) {
+    std::cerr << "cts_client: cannot send the request to cts_server\n";
+    ::close(fd);
+    return EXIT_FAILURE;
+  }
+
+  // The server writes the output of the run to our stdout and stderr, the
+  // connection only carries the exit code
+  std::string response;
+  char buffer[64];
+  for (;;) {
+    const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) break;
+    response.append(buffer, static_cast<size_t>(count));
+  }
+  ::close(fd);
+
+  int exitCode = EXIT_FAILURE;
+  if (!parse_decimal(response, exitCode)) {
+    std::cerr << "cts_client: cts_server closed the connection before the "
+                 "run finished, a test case probably crashed it\n";
+    return EXIT_FAILURE;
+  }
+  return exitCode;
+}
@@ -26,33 +26,20 @@
 
 #include "../../util/device_manager.h"
 
-#include <regex>
-
 namespace {
 
 /** device selection operator
  *  return <  0  : device will never be selected
  *  return >= 0  : positive device rating
+ *
+ *  The CTS device is resolved once by the device_manager, so only that
+ *  device is ever selected.
  */
 int cts_selector(const sycl::device& dev) {
   using namespace sycl_cts;
   using namespace sycl_cts::util;
 
-  auto& device_regex = get<device_manager>().get_device_regex();
-
-  if (!device_regex.has_value()) {
-    return sycl::default_selector_v(dev);
-  }
-
-  const auto platform_name =
-      dev.get_platform().get_info<sycl::info::platform::name>();
-  const auto device_name = dev.get_info<sycl::info::device::name>();
-
-  if (std::regex_search(platform_name + " / " + device_name, *device_regex)) {
-    return 1000;
-  }
-
-  return -1;
+  return dev == get<device_manager>().get_device() ? 1 : -1;
 }
 
 }  // namespace
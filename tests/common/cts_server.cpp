@@ -0,0 +1,399 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Long-lived host running the test categories built as shared libraries
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include <catch2/catch_session.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/interfaces/catch_interfaces_registry_hub.hpp>
+#include <catch2/interfaces/catch_interfaces_testcase.hpp>
+#include <catch2/internal/catch_clara.hpp>
+#include <catch2/internal/catch_test_case_registry_impl.hpp>
+
+#include "./../../util/device_manager.h"
+#include "./../../util/parallel_session.h"
+#include "cts_cli.h"
+#include "test_server_protocol.h"
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace sycl_cts;
+
+/** Names of the test cases registered by each loaded category */
+using category_map = std::map<std::string, std::set<std::string>>;
+
+size_t registered_test_count() {
+  return Catch::getRegistryHub().getTestCaseRegistry().getAllTests().size();
+}
+
+/**
+ * Loads the category library at file. Catch2 sorts its test case registry
+ * once, so all categories have to be loaded before the first run.
+ */
+bool load_category(const std::string& file, category_map& categories) {
+  const size_t firstTest = registered_test_count();
+  // Categories stay loaded for the lifetime of the server
+  if (dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL) == nullptr) {
+    std::cerr << "cts_server: " << dlerror() << '\n';
+    return false;
+  }
+  const auto& tests =
+      Catch::getRegistryHub().getTestCaseRegistry().getAllTests();
+  auto& names = categories[std::filesystem::path(file).stem().string()];
+  for (size_t i = firstTest; i < tests.size(); ++i) {
+    names.insert(tests[i].getTestCaseInfo().name);
+  }
+  return true;
+}
+
+/**
+ * Sends everything written to stdout and stderr to outFd and errFd while alive
+ */
+class output_redirect {
+ public:
+  output_redirect(int outFd, int errFd) {
+    flush();
+    m_stdout = ::dup(STDOUT_FILENO);
+    m_stderr = ::dup(STDERR_FILENO);
+    ::dup2(outFd, STDOUT_FILENO);
+    ::dup2(errFd, STDERR_FILENO);
+  }
+  output_redirect(const output_redirect&) = delete;
+  output_redirect& operator=(const output_redirect&) = delete;
+  ~output_redirect() {
+    flush();
+    ::dup2(m_stdout, STDOUT_FILENO);
+    ::dup2(m_stderr, STDERR_FILENO);
+    ::close(m_stdout);
+    ::close(m_stderr);
+  }
+
+ private:
+  static void flush() {
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(stdout);
+    std::fflush(stderr);
+  }
+
+  int m_stdout;
+  int m_stderr;
+};
+
+/**
+ * Runs the test cases of a category selected by args, the command line of
+ * its test executable
+ */
+int run_tests(Catch::Session& session, const Catch::ConfigData& defaults,
+              const Catch::Clara::Parser& catchCli,
+              const std::set<std::string>& categoryTests,
+              const std::vector<std::string>& args) {
+  cli_options options;
+  session.useConfigData(defaults);
+  session.cli(make_cli(options, catchCli));
+
+  std::string serverName = "cts_server";
+  std::vector<char*> argv{serverName.data()};
+  std::vector<std::string> argsCopy = args;
+  for (auto& arg : argsCopy) argv.push_back(arg.data());
+  const int returnCode =
+      session.applyCommandLine(static_cast<int>(argv.size()), argv.data());
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  apply_cli_options(options);
+
+  // The device is selected once when the server starts
+  auto& device_mngr = util::get<util::device_manager>();
+  if (options.listDevices) {
+    device_mngr.list_devices();
+    return EXIT_SUCCESS;
+  }
+  if (!options.infoDumpFile.empty()) {
+    device_mngr.dump_info(options.infoDumpFile);
+  }
+  if (options.jobs > 1) {
+    std::cerr << "cts_server: --jobs is ignored, test cases run in the "
+                 "server process\n";
+  }
+
+  const auto& config = session.config();
+  std::vector<std::string> testNames;
+  for (const auto& testCase : Catch::filterTests(
+           Catch::getAllTestCasesSorted(config), config.testSpec(), config)) {
+    const auto& name = testCase.getTestCaseInfo().name;
+    if (categoryTests.count(name) != 0) testNames.push_back(name);
+  }
+  if (testNames.empty()) {
+    // Catch2 fails the same way when no test case runs
+    std::cerr << "cts_server: no test cases of the category selected\n";
+    return 2;
+  }
+  util::select_tests(session, testNames);
+  prebuild_kernels(options);
+  return session.run();
+}
+
+/**
+ * Answers a request with exitCode, after writing message to the stderr of the
+ * client
+ */
+void respond(int fd, int errFd, const std::string& message, int exitCode) {
+  test_server::write_all(errFd, message.data(), message.size());
+  const std::string response = std::to_string(exitCode);
+  test_server::write_all(fd, response.data(), response.size());
+}
+
+/**
+ * Forks the server into the background. The parent exits once the server
+ * signals that it is ready through the returned pipe, so that a CTest fixture
+ * starting the server completes only once requests can be served.
+ */
+int detach() {
+  int readyPipe[2];
+  if (::pipe(readyPipe) != 0) {
+    std::perror("cts_server");
+    std::exit(EXIT_FAILURE);
+  }
+  const pid_t pid = ::fork();
+  if (pid < 0) {
+    std::perror("cts_server");
+    std::exit(EXIT_FAILURE);
+  }
+  if (pid > 0) {
+    ::close(readyPipe[1]);
+    char ready = 0;
+    const bool isReady = ::read(readyPipe[0], &ready, 1) == 1 && ready == 1;
+    std::exit(isReady ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+  ::close(readyPipe[0]);
+  ::setsid();
+  return readyPipe[1];
+}
+
+/**
+ * Releases the output pipes of whoever started the server
+ */
+void release_output() {
+  const int devNull = ::open("/dev/null", O_RDWR);
+  ::dup2(devNull, STDIN_FILENO);
+  ::dup2(devNull, STDOUT_FILENO);
+  ::dup2(devNull, STDERR_FILENO);
+  ::close(devNull);
+}
+
+void signal_ready(int readyFd) {
+  const char ready = 1;
+  test_server::write_all(readyFd, &ready, 1);
+  ::close(readyFd);
+}
+
+/** Command line of the server */
+struct server_options {
+  std::string socketPath;
+  std::string devicePattern;
+  std::vector<std::string> categoryFiles;
+  bool runDetached = false;
+};
+
+/**
+ * Initializes the runtime, loads the categories and serves requests on server
+ * until a shutdown request arrives. readyFd is signaled once requests can be
+ * served.
+ */
+int serve(int server, const server_options& serverOptions, int readyFd) {
+  // Pay for runtime and platform initialization once
+  auto& device_mngr = util::get<util::device_manager>();
+  if (!serverOptions.devicePattern.empty()) {
+    device_mngr.set_device_regex(std::regex(serverOptions.devicePattern));
+  }
+  try {
+    device_mngr.get_device();
+  } catch (const std::exception& e) {
+    std::cerr << "cts_server: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  category_map categories;
+  for (const auto& file : serverOptions.categoryFiles) {
+    if (!load_category(file, categories)) return EXIT_FAILURE;
+  }
+  if (serverOptions.runDetached) release_output();
+  signal_ready(readyFd);
+
+  Catch::Session session;
+  session.configData().name = "The SYCL 2020 Conformance Test Suite";
+  const auto defaults = session.configData();
+  const auto catchCli = session.cli();
+
+  // Requests are served one at a time, as Catch2 is not thread-safe
+  for (;;) {
+    const int client = ::accept(server, nullptr, nullptr);
+    if (client < 0) {
+      if (errno == EINTR) continue;
+      std::perror("cts_server");
+      return EXIT_FAILURE;
+    }
+    std::vector<std::string> request;
+    int outFd = -1;
+    int errFd = -1;
+    if (!test_server::receive_request(client, request) || request.empty() ||
+        !test_server::receive_output_fds(client, outFd, errFd)) {
+      ::close(client);
+      continue;
+    }
+    const auto finish = [&](const std::string& message, int exitCode) {
+      respond(client, errFd, message, exitCode);
+      ::close(outFd);
+      ::close(errFd);
+      ::close(client);
+    };
+    if (request[0] == test_server::shutdown_command) {
+      finish("", EXIT_SUCCESS);
+      return EXIT_SUCCESS;
+    }
+    if (request[0] != test_server::run_command || request.size() < 2) {
+      finish("cts_server: invalid request\n", EXIT_FAILURE);
+      continue;
+    }
+    const auto category = categories.find(request[1]);
+    if (category == categories.end()) {
+      finish("cts_server: unknown category " + request[1] + '\n',
+             EXIT_FAILURE);
+      continue;
+    }
+
+    int exitCode = EXIT_FAILURE;
+    {
+      output_redirect redirect(outFd, errFd);
+      try {
+        exitCode = run_tests(
+            session, defaults, catchCli, category->second,
+            std::vector<std::string>(request.begin() + 2, request.end()));
+      } catch (const std::exception& e) {
+        std::cerr << "cts_server: " << e.what() << '\n';
+      }
+    }
+    finish("", exitCode);
+  }
+}
+
+/**
+ * Runs serve() in a child process and starts a new one whenever a test takes
+ * the child down, so that a crash only fails the category that was running.
+ * The listening socket stays open in this process, so requests arriving
+ * during the restart wait for the new child. Returns once the child shut down
+ * on request, or failed before it was ready to serve.
+ */
+int supervise(int server, const server_options& serverOptions, int readyFd) {
+  for (bool firstStart = true;; firstStart = false) {
+    int childReady[2];
+    if (::pipe(childReady) != 0) {
+      std::perror("cts_server");
+      return EXIT_FAILURE;
+    }
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+      std::perror("cts_server");
+      return EXIT_FAILURE;
+    }
+    if (pid == 0) {
+      ::close(childReady[0]);
+      if (readyFd >= 0) ::close(readyFd);
+      std::exit(serve(server, serverOptions, childReady[1]));
+    }
+
+    ::close(childReady[1]);
+    char ready = 0;
+    const bool isReady = ::read(childReady[0], &ready, 1) == 1 && ready == 1;
+    ::close(childReady[0]);
+    if (isReady && firstStart && readyFd >= 0) {
+      release_output();
+      signal_ready(readyFd);
+    }
+
+    int status = 0;
+    while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+    }
+    if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+      return EXIT_SUCCESS;
+    }
+    if (!isReady) {
+      std::cerr << "cts_server: failed to start\n";
+      return EXIT_FAILURE;
+    }
+    std::cerr << "cts_server: server process died, restarting it\n";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using namespace sycl_cts;
+
+  server_options serverOptions;
+
+  using namespace Catch::Clara;
+  auto cli = Opt(serverOptions.socketPath, "path")["--socket"](
+                 "UNIX domain socket to serve requests of cts_client on") |
+             Opt(serverOptions.devicePattern, "pattern")["--device"](
+                 "Select SYCL device to run CTS on. ECMAScript "
+                 "regular expression syntax can be used") |
+             Opt(serverOptions.categoryFiles, "file")["--category"](
+                 "Test category library to load, can be repeated") |
+             Opt(serverOptions.runDetached)["--detach"](
+                 "Run in the background once ready to serve requests");
+  const auto result = cli.parse(Args(argc, argv));
+  if (!result || serverOptions.socketPath.empty()) {
+    std::cerr << "cts_server: "
+              << (result ? "--socket is required" : result.errorMessage())
+              << "\n\n"
+              << cli;
+    return EXIT_FAILURE;
+  }
+
+  const int readyFd = serverOptions.runDetached ? detach() : -1;
+  ::signal(SIGPIPE, SIG_IGN);
+
+  const std::string& socketPath = serverOptions.socketPath;
+  sockaddr_un address;
+  if (!test_server::make_address(socketPath, address)) {
+    std::cerr << "cts_server: socket path too long: " << socketPath << '\n';
+    return EXIT_FAILURE;
+  }
+  const int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  ::unlink(socketPath.c_str());
+  if (server < 0 ||
+      ::bind(server, reinterpret_cast<const sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+      ::listen(server, SOMAXCONN) != 0) {
+    std::perror("cts_server");
+    return EXIT_FAILURE;
+  }
+
+  const int exitCode = supervise(server, serverOptions, readyFd);
+  ::close(server);
+  ::unlink(socketPath.c_str());
+  return exitCode;
+}
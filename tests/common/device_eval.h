@@ -27,13 +27,18 @@
 #define DEVICE_EVAL_T(T, expr, ...)                                 \
   ([=] {                                                            \
     sycl::buffer<std::decay_t<T>, 1> result_buf{1};                 \
-    sycl_cts::util::get_cts_object::queue()                         \
-        .submit([=, &result_buf](sycl::handler& cgh) {              \
-          sycl::accessor result{result_buf, cgh, sycl::write_only}; \
-          cgh.single_task<__VA_ARGS__>([=] { result[0] = expr; });  \
-        })                                                          \
-        .wait_and_throw();                                          \
-    sycl::host_accessor acc{result_buf, sycl::read_only};           \
+    const auto event =                                              \
+        sycl_cts::util::get_cts_object::queue().submit(             \
+            [=, &result_buf](sycl::handler& cgh) {                  \
+              sycl::accessor result{result_buf, cgh,                \
+                                    sycl::write_only};              \
+              cgh.single_task<__VA_ARGS__>(                         \
+                  [=] { result[0] = expr; });                       \
+            });                                                     \
+    sycl_cts::util::traced_wait_and_throw(event);                   \
+    sycl_cts::util::record_kernel_profile(event);                   \
+    const auto acc = sycl_cts::util::traced_host_accessor(          \
+        result_buf, sycl::read_only);                               \
     return acc[0];                                                  \
   })()
 
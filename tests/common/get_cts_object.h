@@ -24,10 +24,12 @@
 
 #include <sycl/sycl.hpp>
 
+#include "../../util/kernel_profiler.h"
 #include "../common/cts_async_handler.h"
 #include "../common/cts_selector.h"
 
 #include <cassert>
+#include <type_traits>
 
 /** @brief dummy kernel functor for checks that don't require a kernel
  */
@@ -45,6 +47,20 @@ namespace util {
   async handler
 */
 struct get_cts_object {
+  /**
+    @brief Checks whether the selector given is the CTS selector, in which case
+    the device resolved by the device_manager can be used directly instead of
+    enumerating all devices
+  */
+  template <class DeviceSelector>
+  static bool is_cts_selector(DeviceSelector selector) {
+    if constexpr (std::is_same_v<DeviceSelector, decltype(&cts_selector)>) {
+      return selector == &cts_selector;
+    } else {
+      return false;
+    }
+  }
+
   /**
     @brief Creates a SYCL device
     @param selector Device selector to use to create the device. Uses the CTS
@@ -53,6 +69,9 @@ struct get_cts_object {
   */
   template <class DeviceSelector = decltype(cts_selector)>
   static sycl::device device(const DeviceSelector &selector = cts_selector) {
+    if (is_cts_selector(selector)) {
+      return get<device_manager>().get_device();
+    }
     return sycl::device(selector);
   }
 
@@ -65,11 +84,18 @@ struct get_cts_object {
   template <class DeviceSelector = decltype(cts_selector)>
   static sycl::platform platform(
       const DeviceSelector &selector = cts_selector) {
+    if (is_cts_selector(selector)) {
+      return get<device_manager>().get_device().get_platform();
+    }
     return sycl::platform(selector);
   }
 
   /**
     @brief Creates a SYCL queue using the CTS async handler
+    @details Every call creates a distinct queue. Tests that don't require a
+    queue of their own should use the queue shared by the whole process
+    from util::sycl_object_cache instead. Profiling is enabled on the queue
+    when the CTS runs with `--profile-kernels` and the device supports it.
     @param selector Device selector to use to create the queue. Uses the CTS
     selector by default.
     @return Default SYCL queue
@@ -77,12 +103,10 @@ struct get_cts_object {
   template <class DeviceSelector = decltype(cts_selector)>
   static sycl::queue queue(DeviceSelector selector = cts_selector) {
     static cts_async_handler asyncHandler;
-#if !SYCL_CTS_COMPILING_WITH_HIPSYCL
-    return sycl::queue(selector, asyncHandler, sycl::property_list{});
-#else
-    return sycl::queue(sycl::device(selector), asyncHandler,
-                       sycl::property_list{});
-#endif
+    trace_span span("get_cts_object::queue", "queue");
+    const sycl::device queueDevice = device(selector);
+    return sycl::queue(queueDevice, asyncHandler,
+                       get<kernel_profiler>().queue_properties(queueDevice));
   }
 
   /**
@@ -94,7 +118,7 @@ struct get_cts_object {
   template <class DeviceSelector = decltype(cts_selector)>
   static sycl::context context(const DeviceSelector &selector = cts_selector) {
     static cts_async_handler asyncHandler;
-    return sycl::context(sycl::device(selector), asyncHandler);
+    return sycl::context(device(selector), asyncHandler);
   }
 
   /**
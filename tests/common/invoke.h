@@ -108,7 +108,7 @@ std::array<typename kernelInvokeT::parameterT, numItems> store_instances()
                                      sycl::range<1>(items.size()));
 
     auto queue = sycl_cts::util::get_cts_object::queue();
-    queue.submit([&](sycl::handler& cgh) {
+    const auto event = queue.submit([&](sycl::handler& cgh) {
       auto itemAcc =
           itemBuf.template get_access<sycl::access_mode::write>(cgh);
 
@@ -118,7 +118,8 @@ std::array<typename kernelInvokeT::parameterT, numItems> store_instances()
               itemAcc[index] = item;
       });
     });
-    queue.wait_and_throw();
+    sycl_cts::util::record_kernel_profile(event);
+    sycl_cts::util::traced_wait_and_throw(queue);
   }
   return items;
 }
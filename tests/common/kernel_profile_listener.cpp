@@ -0,0 +1,74 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include "./../../util/kernel_profiler.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Attributes the commands recorded for `--profile-kernels` to the running
+ * test case and section, and prints the totals at the end of the run.
+ */
+class kernel_profile_listener : public Catch::EventListenerBase {
+ public:
+  using Catch::EventListenerBase::EventListenerBase;
+
+  void testRunStarting(const Catch::TestRunInfo&) override {
+    profiler().clear();
+  }
+
+  void testCaseStarting(const Catch::TestCaseInfo& info) override {
+    m_testCase = info.name;
+  }
+
+  void sectionStarting(const Catch::SectionInfo& info) override {
+    m_sections.push_back(info.name);
+    if (profiler().enabled()) profiler().set_scope(m_testCase, path());
+  }
+
+  void sectionEnded(const Catch::SectionStats& stats) override {
+    if (profiler().enabled()) {
+      profiler().end_scope(m_testCase, path(), stats.durationInSeconds);
+    }
+    m_sections.pop_back();
+    if (profiler().enabled()) profiler().set_scope(m_testCase, path());
+  }
+
+  void testRunEnded(const Catch::TestRunStats&) override {
+    if (profiler().enabled()) profiler().write(std::cout);
+  }
+
+ private:
+  static sycl_cts::util::kernel_profiler& profiler() {
+    return sycl_cts::util::get<sycl_cts::util::kernel_profiler>();
+  }
+
+  /** Sections below the outermost one, which is the test case itself */
+  std::string path() const {
+    std::string result;
+    for (size_t i = 1; i < m_sections.size(); ++i) {
+      if (!result.empty()) result += " / ";
+      result += m_sections[i];
+    }
+    return result;
+  }
+
+  std::string m_testCase;
+  std::vector<std::string> m_sections;
+};
+
+}  // namespace
+
+CATCH_REGISTER_LISTENER(kernel_profile_listener)
@@ -6,15 +6,17 @@
 //
 *******************************************************************************/
 
+#include <iostream>
 #include <regex>
 #include <string>
 
 #define CATCH_CONFIG_RUNNER
 #include <catch2/catch_session.hpp>
 #include <catch2/catch_test_macros.hpp>
-#include <catch2/internal/catch_clara.hpp>
 
 #include "./../../util/device_manager.h"
+#include "./../../util/parallel_session.h"
+#include "cts_cli.h"
 #include "cts_selector.h"
 
 int main(int argc, char** argv) {
@@ -23,42 +25,48 @@ int main(int argc, char** argv) {
   Catch::Session session;
   session.configData().name = "The SYCL 2020 Conformance Test Suite";
 
-  std::string devicePattern;
-  std::string infoDumpFile;
-  bool listDevices = false;
-
-  using namespace Catch::Clara;
-
-  // TODO: Look into removing some of Catch2's default options
-  //       that we don't need, e.g. for benchmarking.
-  auto cli = Opt(devicePattern, "pattern")["--device"](
-                 "Select SYCL device to run CTS on. ECMAScript "
-                 "regular expression syntax can be used") |
-             Opt(listDevices)["--list-devices"]("List all available devices") |
-             Opt(infoDumpFile, "file")["--info-dump"](
-                 "Dump platform and device info to file") |
-             session.cli();
-
-  session.cli(cli);
+  cli_options options;
+  session.cli(make_cli(options, session.cli()));
 
   const int returnCode = session.applyCommandLine(argc, argv);
   if (returnCode != 0) {
     return returnCode;
   }
 
+  apply_cli_options(options);
+
   auto& device_mngr = util::get<util::device_manager>();
-  if (!devicePattern.empty()) {
-    device_mngr.set_device_regex(std::regex(devicePattern));
+  if (!options.devicePattern.empty()) {
+    device_mngr.set_device_regex(std::regex(options.devicePattern));
   }
 
-  if (listDevices) {
+  if (options.listDevices) {
     device_mngr.list_devices();
     return EXIT_SUCCESS;
   }
 
-  if (!infoDumpFile.empty()) {
-    device_mngr.dump_info(infoDumpFile);
+  // Worker processes only run tests, the device info is dumped by the parent.
+  // They don't prebuild kernels either, as each would build all kernels of the
+  // executable for its subset of the test cases.
+  if (!options.workerTestsFile.empty()) {
+    util::apply_worker_tests(session, options.workerTestsFile);
+    return session.run();
+  }
+
+  if (!options.infoDumpFile.empty()) {
+    device_mngr.dump_info(options.infoDumpFile);
+  }
+
+  const auto& configData = session.configData();
+  const bool runsTests =
+      !configData.showHelp && !configData.listTests && !configData.listTags;
+  if (options.jobs > 1 && runsTests) {
+    if (options.prebuildThreads >= 0) {
+      std::cerr << "--prebuild-kernels is ignored with --jobs\n";
+    }
+    return util::run_parallel_session(session, argc, argv, options.jobs);
   }
 
+  if (runsTests) prebuild_kernels(options);
   return session.run();
 }
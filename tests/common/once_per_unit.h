@@ -9,6 +9,7 @@
 #ifndef __SYCLCTS_TESTS_COMMON_ONCE_PER_UNIT_H
 #define __SYCLCTS_TESTS_COMMON_ONCE_PER_UNIT_H
 
+#include "../../util/sycl_object_cache.h"
 #include "../common/get_cts_object.h"
 
 namespace detail {
@@ -30,10 +31,15 @@ namespace {
  */
 namespace once_per_unit {
 /**
- * @brief Factory method; provides unique queue instance per compilation unit
+ * @brief Factory method; provides queue instance for the compilation unit
+ * @details The queue is shared by the whole process, see
+ *          sycl_cts::util::sycl_object_cache
  */
 inline sycl::queue &get_queue() {
-  static auto q = sycl_cts::util::get_cts_object::queue();
+  static auto &q = []() -> sycl::queue & {
+    sycl_cts::util::trace_span span("once_per_unit::get_queue", "queue");
+    return sycl_cts::util::get<sycl_cts::util::sycl_object_cache>().queue();
+  }();
   return q;
 }
 
@@ -144,7 +144,7 @@ class on_device_checker {
                                     sycl::range<1>(success.size()));
 
       auto queue = sycl_cts::util::get_cts_object::queue();
-      queue.submit([&](sycl::handler& cgh) {
+      const auto event = queue.submit([&](sycl::handler& cgh) {
         auto itemAcc =
             itemBuf.template get_access<sycl::access_mode::read>(cgh);
         auto successAcc = successBuf.get_access<sycl::access_mode::write>(cgh);
@@ -187,6 +187,7 @@ class on_device_checker {
               (c != other);
         });
       });
+      sycl_cts::util::record_kernel_profile(event);
     }
 
     /** check for reflexivity success
@@ -488,7 +488,7 @@ void check_kernel(InitFunc init_func, const std::string& type_name) {
     sycl::buffer<int> buffer(results.data(), sycl::range<1>{result_count});
 
     auto queue = sycl_cts::util::get_cts_object::queue();
-    queue.submit([&](sycl::handler& cgh) {
+    const auto event = queue.submit([&](sycl::handler& cgh) {
       auto accessor = buffer.template get_access<sycl::access_mode::write>(cgh);
       T t = init_func(cgh);
       // use non-simple parallel_for to be able to use local_accessor
@@ -506,6 +506,7 @@ void check_kernel(InitFunc init_func, const std::string& type_name) {
                    ptr - accessor.begin());
           });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
 
   auto ptr = results.data();
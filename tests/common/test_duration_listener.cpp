@@ -0,0 +1,64 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include "./../../util/json.h"
+#include "cts_cli.h"
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Prints a `[test-duration]` line with the wall time of each test case after
+ * the run when requested with `--test-durations`, which CTest does.
+ * run_conformance_tests.py reads these lines from the test output.
+ */
+class test_duration_listener : public Catch::EventListenerBase {
+ public:
+  using Catch::EventListenerBase::EventListenerBase;
+
+  void testCaseStarting(const Catch::TestCaseInfo& info) override {
+    m_durations.emplace_back(info.name, 0.0);
+    m_depth = 0;
+  }
+
+  void sectionStarting(const Catch::SectionInfo&) override { ++m_depth; }
+
+  void sectionEnded(const Catch::SectionStats& stats) override {
+    // The outermost section is the test case itself, which runs once for each
+    // leaf section
+    if (--m_depth == 0) m_durations.back().second += stats.durationInSeconds;
+  }
+
+  void testRunEnded(const Catch::TestRunStats&) override {
+    if (!sycl_cts::util::get<sycl_cts::cts_cli>().test_durations()) return;
+    const auto flags = std::cout.flags();
+    std::cout << std::fixed << std::setprecision(6);
+    for (const auto& [testCase, seconds] : m_durations) {
+      std::cout << "[test-duration] {\"test-case\": "
+                << sycl_cts::util::json_string(testCase)
+                << ", \"seconds\": " << seconds << "}\n";
+    }
+    std::cout.flags(flags);
+  }
+
+ private:
+  std::vector<std::pair<std::string, double>> m_durations;
+  int m_depth = 0;
+};
+
+}  // namespace
+
+CATCH_REGISTER_LISTENER(test_duration_listener)
@@ -0,0 +1,204 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Protocol between cts_server and cts_client
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_TESTS_COMMON_TEST_SERVER_PROTOCOL_H
+#define __SYCLCTS_TESTS_COMMON_TEST_SERVER_PROTOCOL_H
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace sycl_cts {
+namespace test_server {
+
+/**
+ * A request is a list of strings, each terminated by a NUL character, preceded
+ * by the number of strings in decimal. The first string is the command:
+ *  - run_command, followed by the test category and the command line
+ *    arguments of its test executable
+ *  - shutdown_command, which stops the server
+ *
+ * The request is followed by a single byte carrying the stdout and stderr of
+ * the client as SCM_RIGHTS ancillary data. The server writes the output of
+ * the run to them directly, so the connection only carries the answer: the
+ * exit code of the run as a decimal number, after which the server closes the
+ * connection. No output of a test can be mistaken for the exit code.
+ */
+inline constexpr const char* run_command = "run";
+inline constexpr const char* shutdown_command = "shutdown";
+
+/**
+ * Creates the address of the UNIX domain socket at path
+ * @return false if path is too long for a socket address
+ */
+inline bool make_address(const std::string& path, sockaddr_un& address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) return false;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  return true;
+}
+
+/**
+ * Writes size bytes of data to fd, retrying on partial writes
+ */
+inline bool write_all(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+inline bool send_request(int fd, const std::vector<std::string>& request) {
+  std::string message = std::to_string(request.size());
+  message += '\0';
+  for (const auto& s : request) {
+    message += s;
+    message += '\0';
+  }
+  return write_all(fd, message.data(), message.size());
+}
+
+/**
+ * @return false if the connection was closed before the request ended
+ */
+inline bool receive_request(int fd, std::vector<std::string>& request) {
+  std::vector<std::string> strings;
+  std::string current;
+  size_t expected = 0;
+  bool haveCount = false;
+  char c;
+  while (!haveCount || strings.size() < expected) {
+    const ssize_t count = ::read(fd, &c, 1);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) return false;
+    if (c != '\0') {
+      current += c;
+    } else if (!haveCount) {
+      expected = std::strtoul(current.c_str(), nullptr, 10);
+      haveCount = true;
+      current.clear();
+    } else {
+      strings.push_back(std::move(current));
+      current.clear();
+    }
+  }
+  request = std::move(strings);
+  return true;
+}
+
+/**
+ * Sends outFd and errFd to the other end of the connection fd
+ */
+inline bool send_output_fds(int fd, int outFd, int errFd) {
+  const int fds[2] = {outFd, errFd};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+  char data = 0;
+  iovec iov{&data, 1};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  cmsghdr* header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type = SCM_RIGHTS;
+  header->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(header), fds, sizeof(fds));
+  for (;;) {
+    const ssize_t sent = ::sendmsg(fd, &message, 0);
+    if (sent < 0 && errno == EINTR) continue;
+    return sent == 1;
+  }
+}
+
+/**
+ * Receives the file descriptors sent by send_output_fds()
+ * @return false if the connection did not carry them
+ */
+inline bool receive_output_fds(int fd, int& outFd, int& errFd) {
+  int fds[2];
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fds))] = {};
+  char data = 0;
+  iovec iov{&data, 1};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  ssize_t received;
+  do {
+    received = ::recvmsg(fd, &message, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  const cmsghdr* header = CMSG_FIRSTHDR(&message);
+  if (received != 1 || header == nullptr || header->cmsg_level != SOL_SOCKET ||
+      header->cmsg_type != SCM_RIGHTS ||
+      header->cmsg_len != CMSG_LEN(sizeof(fds))) {
+    return false;
+  }
+  std::memcpy(fds, CMSG_DATA(header), sizeof(fds));
+  outFd = fds[0];
+  errFd = fds[1];
+  return true;
+}
+
+/**
+ * Parses a decimal number, like the exit code the server answers with
+ * @return false unless text is exactly a decimal number
+ */
+inline bool parse_decimal(const std::string& text, int& value) {
+  const char* end = text.data() + text.size();
+  const auto result = std::from_chars(text.data(), end, value);
+  return !text.empty() && result.ec == std::errc{} && result.ptr == end;
+}
+
+/**
+ * Returns the socket path of the server with the given index in a pool of
+ * servers sharing basePath
+ */
+inline std::string get_pool_socket(const std::string& basePath, int index) {
+  return basePath + '.' + std::to_string(index);
+}
+
+/**
+ * Connects to the server listening at path
+ * @return Socket of the connection, -1 on failure
+ */
+inline int connect_to_server(const std::string& path) {
+  sockaddr_un address;
+  if (!make_address(path, address)) return -1;
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  if (::connect(fd, reinterpret_cast<const sockaddr*>(&address),
+                sizeof(address)) != 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}  // namespace test_server
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_TESTS_COMMON_TEST_SERVER_PROTOCOL_H
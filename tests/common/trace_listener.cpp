@@ -0,0 +1,86 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+*******************************************************************************/
+
+#include <catch2/reporters/catch_reporter_event_listener.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+
+#include "./../../util/trace_recorder.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Records the test cases and sections of the run for `--trace` and writes
+ * the trace at the end of the run.
+ */
+class trace_listener : public Catch::EventListenerBase {
+ public:
+  using Catch::EventListenerBase::EventListenerBase;
+
+  void testRunStarting(const Catch::TestRunInfo&) override {
+    recorder().clear();
+  }
+
+  void testCaseStarting(const Catch::TestCaseInfo& info) override {
+    if (!recorder().enabled()) return;
+    m_testCase = info.name;
+    m_testCaseStart = recorder().now();
+    recorder().set_label(m_testCase);
+  }
+
+  void sectionStarting(const Catch::SectionInfo& info) override {
+    if (!recorder().enabled()) return;
+    m_sections.emplace_back(info.name, recorder().now());
+    recorder().set_label(label());
+  }
+
+  void sectionEnded(const Catch::SectionStats&) override {
+    if (!recorder().enabled()) return;
+    // The outermost section is the test case itself
+    if (m_sections.size() > 1) {
+      recorder().complete(m_sections.back().first, "section",
+                          m_sections.back().second);
+    }
+    m_sections.pop_back();
+    recorder().set_label(label());
+  }
+
+  void testCaseEnded(const Catch::TestCaseStats&) override {
+    if (!recorder().enabled()) return;
+    recorder().complete(m_testCase, "test-case", m_testCaseStart);
+    recorder().flush();
+  }
+
+  void testRunEnded(const Catch::TestRunStats&) override {
+    if (recorder().enabled()) recorder().write();
+  }
+
+ private:
+  static sycl_cts::util::trace_recorder& recorder() {
+    return sycl_cts::util::get<sycl_cts::util::trace_recorder>();
+  }
+
+  std::string label() const {
+    std::string result = m_testCase;
+    for (size_t i = 1; i < m_sections.size(); ++i) {
+      result += " / " + m_sections[i].first;
+    }
+    return result;
+  }
+
+  std::string m_testCase;
+  double m_testCaseStart = 0;
+  std::vector<std::pair<std::string, double>> m_sections;
+};
+
+}  // namespace
+
+CATCH_REGISTER_LISTENER(trace_listener)
@@ -0,0 +1,319 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides throughput benchmarks for the 2D copy and fill functions of the
+//  oneapi_memcpy2d extension
+//
+*******************************************************************************/
+
+#include "../../common/benchmark.h"
+#include "memcpy2d_common.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace memcpy2d_bandwidth {
+using namespace memcpy2d_common_tests;
+using namespace sycl_cts;
+
+#ifdef SYCL_EXT_ONEAPI_MEMCPY2D
+
+/** Element type of ext_oneapi_copy2d and ext_oneapi_fill2d */
+using element_t = int;
+
+/** Total sizes of the copied and filled regions, in bytes */
+constexpr size_t region_sizes[] = {256 * 1024, 16 * 1024 * 1024};
+
+/** Region widths, in bytes, from narrow tall regions to wide short ones */
+constexpr size_t region_widths[] = {64, 4 * 1024, 256 * 1024};
+
+/** Padding of the padded pitch, in bytes */
+constexpr size_t pitch_padding = 64;
+
+/**
+ * The row-by-row baseline submits one command per row, so it is only run for
+ * regions with at most this many rows
+ */
+constexpr size_t max_baseline_rows = 16 * 1024;
+
+/**
+ * @brief Width, height and pitch of the source and destination regions, in
+ *        bytes and rows
+ */
+struct region_shape {
+  size_t width;
+  size_t height;
+  size_t pitch;
+
+  size_t bytes() const { return width * height; }
+
+  std::string name() const {
+    return benchmark::size_name(width) + " x " + std::to_string(height) +
+           " rows, pitch " + benchmark::size_name(pitch);
+  }
+};
+
+/**
+ * @brief Returns all benchmarked region shapes: every region size and width,
+ *        each with a dense pitch, a pitch padded by pitch_padding bytes and a
+ *        pitch of twice the width
+ */
+inline std::vector<region_shape> get_region_shapes() {
+  std::vector<region_shape> shapes;
+  for (const auto size : region_sizes) {
+    for (const auto width : region_widths) {
+      if (width > size) continue;
+      std::vector<size_t> pitches;
+      for (const auto pitch : {width, width + pitch_padding, 2 * width}) {
+        if (std::find(pitches.begin(), pitches.end(), pitch) == pitches.end())
+          pitches.push_back(pitch);
+      }
+      for (const auto pitch : pitches) {
+        shapes.push_back({width, size / width, pitch});
+      }
+    }
+  }
+  return shapes;
+}
+
+inline std::string get_pointer_type_name(pointer_type type) {
+  switch (type) {
+    case pointer_type::host:
+      return "host";
+    case pointer_type::usm_host:
+      return "USM host";
+    case pointer_type::usm_device:
+      return "USM device";
+    case pointer_type::usm_shared:
+      return "USM shared";
+  }
+  return "(unknown pointer type)";
+}
+
+/**
+ * @brief Runs the operation submitted by action once and verifies it with
+ *        check, then benchmarks it, waiting for its completion each time
+ */
+template <typename actionT, typename checkT>
+void run_benchmark(sycl::queue& queue, const std::string& name, size_t bytes,
+                   const actionT& action, const checkT& check) {
+  action();
+  queue.wait_and_throw();
+  if (!check()) {
+    FAIL_CHECK(name + " produced wrong results, not benchmarking it");
+    return;
+  }
+
+  benchmark::set_work(bytes);
+  BENCHMARK(std::string(name)) {
+    action();
+    queue.wait_and_throw();
+  };
+}
+
+/**
+ * @brief Allocates a region of the given shape with the given pointer type and
+ *        initializes it with value, so that first-touch costs are not part of
+ *        the benchmark
+ */
+template <pointer_type PtrType>
+auto allocate_region(const region_shape& shape, sycl::queue& queue,
+                     element_t value) {
+  const size_t count = shape.pitch * shape.height / sizeof(element_t);
+  auto storage = allocate_memory<element_t, PtrType>(count, queue);
+  fill_memory<element_t, PtrType>(storage.get(), value, count, queue);
+  return storage;
+}
+
+/**
+ * @brief Checks that the first width bytes of every row of the region hold
+ *        value and the rest of the pitch still holds init_val, then resets
+ *        the region to init_val for the check of the next operation
+ */
+template <pointer_type PtrType>
+bool check_region(sycl::queue& queue, element_t* region,
+                  const region_shape& shape, element_t value) {
+  const size_t e = sizeof(element_t);
+  const size_t count = shape.pitch * shape.height / e;
+  std::vector<element_t> result(count);
+  copy_destination_to_host_result<PtrType>(region, result.data(), count,
+                                           queue);
+  fill_memory<element_t, PtrType>(region, element_t{init_val}, count, queue);
+
+  for (size_t row = 0; row < shape.height; ++row) {
+    for (size_t col = 0; col < shape.pitch / e; ++col) {
+      const auto expected = col < shape.width / e ? value : element_t{init_val};
+      if (result[row * shape.pitch / e + col] != expected) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Benchmarks ext_oneapi_memcpy2d and ext_oneapi_copy2d from SrcPtrT to
+ *        DestPtrT memory, next to a copy with one memcpy per row
+ */
+template <typename SrcPtrT, typename DestPtrT>
+class benchmark_copies {
+  static constexpr pointer_type SrcPtrType = SrcPtrT::value;
+  static constexpr pointer_type DestPtrType = DestPtrT::value;
+
+ public:
+  void operator()(sycl::queue& queue, const region_shape& shape,
+                  const std::string&, const std::string&) {
+    if (!check_device_aspect_allocations<SrcPtrType, DestPtrType>(queue)) {
+      return;
+    }
+    const element_t value{expected_val};
+    auto src = allocate_region<SrcPtrType>(shape, queue, value);
+    auto dest = allocate_region<DestPtrType>(shape, queue, element_t{init_val});
+    auto* srcBytes = reinterpret_cast<unsigned char*>(src.get());
+    auto* destBytes = reinterpret_cast<unsigned char*>(dest.get());
+
+    const auto name = "from " + get_pointer_type_name(SrcPtrType) + " to " +
+                      get_pointer_type_name(DestPtrType) + ", " + shape.name();
+    const size_t e = sizeof(element_t);
+    const auto check = [&] {
+      return check_region<DestPtrType>(queue, dest.get(), shape, value);
+    };
+
+    run_benchmark(
+        queue, "memcpy2d " + name, shape.bytes(),
+        [&] {
+          queue.submit([&](sycl::handler& cgh) {
+            cgh.ext_oneapi_memcpy2d(destBytes, shape.pitch, srcBytes,
+                                    shape.pitch, shape.width, shape.height);
+          });
+        },
+        check);
+    run_benchmark(
+        queue, "copy2d " + name, shape.bytes(),
+        [&] {
+          queue.submit([&](sycl::handler& cgh) {
+            cgh.ext_oneapi_copy2d(src.get(), shape.pitch / e, dest.get(),
+                                  shape.pitch / e, shape.width / e,
+                                  shape.height);
+          });
+        },
+        check);
+    if (shape.height <= max_baseline_rows) {
+      run_benchmark(
+          queue, "row-by-row memcpy " + name, shape.bytes(),
+          [&] {
+            for (size_t row = 0; row < shape.height; ++row) {
+              queue.memcpy(destBytes + row * shape.pitch,
+                           srcBytes + row * shape.pitch, shape.width);
+            }
+          },
+          check);
+    }
+  }
+};
+
+/**
+ * @brief Benchmarks ext_oneapi_fill2d and ext_oneapi_memset2d of DestPtrT
+ *        memory, next to a fill with one command per row
+ */
+template <typename DestPtrT>
+class benchmark_fills {
+  static constexpr pointer_type DestPtrType = DestPtrT::value;
+
+ public:
+  void operator()(sycl::queue& queue, const region_shape& shape,
+                  const std::string&) {
+    if (!check_device_aspect_allocations<DestPtrType>(queue)) {
+      return;
+    }
+    auto dest = allocate_region<DestPtrType>(shape, queue, element_t{init_val});
+    auto* destBytes = reinterpret_cast<unsigned char*>(dest.get());
+
+    const auto name = get_pointer_type_name(DestPtrType) + ", " + shape.name();
+    const size_t e = sizeof(element_t);
+    const element_t pattern{expected_val};
+    // Value of each element after setting all its bytes to expected_val
+    element_t memsetValue;
+    std::memset(&memsetValue, expected_val, sizeof(memsetValue));
+    const auto check_memset = [&] {
+      return check_region<DestPtrType>(queue, dest.get(), shape, memsetValue);
+    };
+    const auto check_fill = [&] {
+      return check_region<DestPtrType>(queue, dest.get(), shape, pattern);
+    };
+
+    run_benchmark(
+        queue, "memset2d " + name, shape.bytes(),
+        [&] {
+          queue.submit([&](sycl::handler& cgh) {
+            cgh.ext_oneapi_memset2d(destBytes, shape.pitch, expected_val,
+                                    shape.width, shape.height);
+          });
+        },
+        check_memset);
+    run_benchmark(
+        queue, "fill2d " + name, shape.bytes(),
+        [&] {
+          queue.submit([&](sycl::handler& cgh) {
+            cgh.ext_oneapi_fill2d(dest.get(), shape.pitch / e, pattern,
+                                  shape.width / e, shape.height);
+          });
+        },
+        check_fill);
+    if (shape.height <= max_baseline_rows) {
+      run_benchmark(
+          queue, "row-by-row memset " + name, shape.bytes(),
+          [&] {
+            for (size_t row = 0; row < shape.height; ++row) {
+              queue.memset(destBytes + row * shape.pitch, expected_val,
+                           shape.width);
+            }
+          },
+          check_memset);
+      run_benchmark(
+          queue, "row-by-row fill " + name, shape.bytes(),
+          [&] {
+            for (size_t row = 0; row < shape.height; ++row) {
+              queue.fill(dest.get() + row * shape.pitch / e, pattern,
+                         shape.width / e);
+            }
+          },
+          check_fill);
+    }
+  }
+};
+
+#endif  // SYCL_EXT_ONEAPI_MEMCPY2D
+
+TEST_CASE("Throughput of the memcpy2d extension",
+          "[oneapi_memcpy2d][benchmark][serial]") {
+#if !defined(SYCL_EXT_ONEAPI_MEMCPY2D)
+  SKIP("SYCL_EXT_ONEAPI_MEMCPY2D is not defined");
+#else
+  auto queue = sycl_cts::util::get_cts_object::queue();
+
+  for (const auto& shape : get_region_shapes()) {
+    for_all_combinations<benchmark_copies>(get_pointer_types(),
+                                           get_pointer_types(), queue, shape);
+    for_all_combinations<benchmark_fills>(get_pointer_types(), queue, shape);
+  }
+#endif
+}
+
+}  // namespace memcpy2d_bandwidth
@@ -316,6 +316,9 @@ using id_helper = range_id_helper<sycl::id, dims, 0>;
  * copying a range [4,8] to [4,8], it will copy [4,8] to [8,4]. If the source
  * and target dimensions don't match, dimensions will be condensed in reverse
  * order (see copy_test_context::setup_ranges).
+ *
+ * The buffer range of the larger dimensionality defaults to 5x7x9 items, so
+ * that correctness tests stay fast. Benchmarks pass a larger extent instead.
  */
 template <typename dataT, int dim_src, int dim_dst, bool strided_copy,
           bool transposed_copy>
@@ -326,8 +329,10 @@ class copy_test_context {
   using th = type_helper<dataT>;
 
  public:
-  explicit copy_test_context(sycl::queue& queue) : queue(queue) {
-    setup_ranges();
+  explicit copy_test_context(sycl::queue& queue,
+                             sycl::range<3> largeExtent = {5, 7, 9})
+      : queue(queue) {
+    setup_ranges(largeExtent);
 
     srcBufHostMemory =
         host_shared_ptr(new dataT[numElems], std::default_delete<dataT[]>());
@@ -620,13 +625,16 @@ class copy_test_context {
    *
    * If the dimensions match, the ranges and offsets will be equal, unless
    * transposed_copy is set, in which case the destination will be transposed.
+   *
+   * @param largeExtent Buffer range of the larger dimensionality, only its
+   *        first dim_large components are used.
    */
-  void setup_ranges() {
+  void setup_ranges(sycl::range<3> largeExtent) {
     constexpr auto dim_large = dim_src > dim_dst ? dim_src : dim_dst;
     constexpr auto dim_small = dim_src <= dim_dst ? dim_src : dim_dst;
 
-    auto largeBufRange =
-        range_helper<3>::cast(range_helper<dim_large>::make(5, 7, 9));
+    auto largeBufRange = range_helper<3>::cast(range_helper<dim_large>::make(
+        largeExtent[0], largeExtent[1], largeExtent[2]));
     auto smallBufRange = sycl::range<3>(1, 1, 1);
 
     // Condense large range into small range so that both
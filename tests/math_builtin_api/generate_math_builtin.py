@@ -24,6 +24,9 @@
 import os
 import sys
 import argparse
+sys.path.append('../common/')
+from common_python_vec import (write_file_if_changed, split_into_shards,
+                               shard_file_name)
 from modules import sycl_types
 from modules import sycl_functions
 from modules import test_generator
@@ -49,7 +52,7 @@ def contains_base_type(sig, base_type):
             return True
     return False
 
-def write_cases_to_file(generated_test_cases, inputFile, outputFile, extension=None):
+def write_cases_to_file(generated_test_cases, inputFile, outputFile, extension=None, seed=0):
     # Determine generator directory
     generatorDirectory = os.path.dirname(os.path.realpath(__file__))
 
@@ -69,12 +72,12 @@ def write_cases_to_file(generated_test_cases, inputFile, outputFile, extension=N
     else:
         extension = "#ifdef __SYCL_DEVICE_ONLY__\n#ifdef $s\n#pragma OPENCL EXTENSION %s : enable\n#endif\n#endif" % extension
     newSource = newSource.replace("$pragma_ext", extension)
+    newSource = newSource.replace("$seed", str(seed))
 
     # Write the source to the output file
-    with open(outputFile, 'w+') as output:
-        output.write(newSource)
+    write_file_if_changed(outputFile, newSource)
 
-def create_tests(test_id, types, signatures, kind, template, file_name, check = False):
+def create_tests(test_id, types, signatures, kind, template, file_name, check = False, batch_size = 1, shard_count = 1, sweep = False, seed = 0):
     expanded_signatures =  test_generator.expand_signatures(types, signatures)
 
     # Extensions should be placed on separate files.
@@ -91,18 +94,26 @@ def create_tests(test_id, types, signatures, kind, template, file_name, check =
         base_signatures.append(sig)
 
     if base_signatures and kind == 'base':
-        generated_base_test_cases = test_generator.generate_test_cases(test_id, types, base_signatures, check)
-        write_cases_to_file(generated_base_test_cases, template, file_name)
+        blocks = test_generator.generate_test_case_blocks(test_id, types, base_signatures, check, batch_size, sweep, seed)
+        extension = None
     elif half_signatures and kind == 'half':
-        generated_half_test_cases = test_generator.generate_test_cases(test_id + 300000, types, half_signatures, check)
-        write_cases_to_file(generated_half_test_cases, template, file_name, "fp16")
+        blocks = test_generator.generate_test_case_blocks(test_id + 300000, types, half_signatures, check, batch_size, sweep, seed)
+        extension = "fp16"
     elif double_signatures and kind == 'double':
-        generated_double_test_cases = test_generator.generate_test_cases(test_id + 600000, types, double_signatures, check)
-        write_cases_to_file(generated_double_test_cases, template, file_name, "fp64")
+        blocks = test_generator.generate_test_case_blocks(test_id + 600000, types, double_signatures, check, batch_size, sweep, seed)
+        extension = "fp64"
     else:
         print("No %s overloads to generate for the test category" % kind)
         sys.exit(1)
 
+    # Test ids are assigned before splitting, so kernel names stay unique
+    # across all shards
+    shards = split_into_shards(blocks, shard_count)
+    for (index, shard) in enumerate(shards):
+        write_cases_to_file("".join(shard), template,
+                            shard_file_name(file_name, index, shard_count),
+                            extension, seed)
+
 def main():
     argparser = argparse.ArgumentParser(
         description='Generates SYCL 2020 mathematical functions test'
@@ -126,6 +137,26 @@ def main():
         choices=['true', 'false'],
         default='false',
         help='Generate tests with marray function arguments')
+    argparser.add_argument(
+        '-batch-size',
+        type=int,
+        default=1,
+        help='Number of test cases without pointer arguments to check with a single kernel')
+    argparser.add_argument(
+        '-sweep',
+        choices=['true', 'false'],
+        default='false',
+        help='Check test cases without pointer arguments with randomized inputs generated at runtime')
+    argparser.add_argument(
+        '-seed',
+        type=int,
+        default=0,
+        help='Seed for the values of the generated test inputs')
+    argparser.add_argument(
+        '-shards',
+        type=int,
+        default=1,
+        help='Number of source files to split the generated test cases into')
     argparser.add_argument(
         '-o',
         dest="output",
@@ -135,6 +166,7 @@ def main():
     args = argparser.parse_args()
 
     use_marray = (args.marray == 'true')
+    use_sweep = (args.sweep == 'true')
     run = runner(use_marray)
     if not use_marray:
         print("WARNING: marray types are not used in the tests!")
@@ -147,31 +179,31 @@ def main():
 
     if args.test == 'integer':
         integer_signatures = sycl_functions.create_integer_signatures()
-        create_tests(0, expanded_types, integer_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(0, expanded_types, integer_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'common':
         common_signatures = sycl_functions.create_common_signatures()
-        create_tests(1000000, expanded_types, common_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(1000000, expanded_types, common_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'geometric':
         geomteric_signatures = sycl_functions.create_geometric_signatures()
-        create_tests(2000000, expanded_types, geomteric_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(2000000, expanded_types, geomteric_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'relational':
         relational_signatures = sycl_functions.create_relational_signatures()
-        create_tests(3000000, expanded_types, relational_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(3000000, expanded_types, relational_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'float':
         float_signatures = sycl_functions.create_float_signatures()
-        create_tests(4000000, expanded_types, float_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(4000000, expanded_types, float_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'native':
         native_signatures = sycl_functions.create_native_signatures()
-        create_tests(5000000, expanded_types, native_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(5000000, expanded_types, native_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
     if args.test == 'half':
         half_signatures = sycl_functions.create_half_signatures()
-        create_tests(6000000, expanded_types, half_signatures, args.variante, args.template, args.output, verifyResults)
+        create_tests(6000000, expanded_types, half_signatures, args.variante, args.template, args.output, verifyResults, args.batch_size, args.shards, use_sweep, args.seed)
 
 if __name__ == "__main__":
     main()
@@ -23,19 +23,21 @@
 #define CL_SYCL_CTS_MATH_BUILTIN_API_MATH_BUILTIN_H
 
 #include "../../util/math_reference.h"
+#include "../../util/math_reference_batch.h"
+#include "../../util/math_sweep.h"
 #include "../../util/accuracy.h"
 #include "../../util/sycl_exceptions.h"
 #include "../common/once_per_unit.h"
 #include <cfloat>
 #include <limits>
+#include <memory>
+#include <tuple>
+#include <vector>
 
 template <int T>
 class kernel;
 
-inline sycl::queue makeQueueOnce() {
-  static sycl::queue q = sycl_cts::util::get_cts_object::queue();
-  return q;
-}
+inline sycl::queue makeQueueOnce() { return once_per_unit::get_queue(); }
 
 template <typename returnT, typename ArgT> struct privatePtrCheck {
   returnT res;
@@ -124,7 +126,7 @@ bool verify(sycl_cts::util::logger &log, sycl::vec<T, N> a,
             const std::string &comment) {
   sycl::vec<T, N> b = r.res;
   for (int i = 0; i < sycl_cts::math::numElements(a); i++)
-    if (r.undefined.find(i) == r.undefined.end() &&
+    if (!r.undefined.test(i) &&
         !verify(log, getElement(a, i), getElement(b, i), accuracy, comment))
       return false;
   return true;
@@ -136,7 +138,7 @@ bool verify(sycl_cts::util::logger &log, sycl::marray<T, N> a,
             const std::string &comment) {
   sycl::marray<T, N> b = r.res;
   for (size_t i = 0; i < N; i++)
-    if (r.undefined.find(i) == r.undefined.end() &&
+    if (!r.undefined.test(i) &&
         !verify(log, a[i], b[i], accuracy, comment))
       return false;
   return true;
@@ -157,12 +159,13 @@ void check_function(sycl_cts::util::logger &log, funT fun,
   auto&& testQueue = once_per_unit::get_queue();
   try {
     sycl::buffer<returnT, 1> buffer(&kernelResult, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr =
           buffer.template get_access<sycl::access_mode::write>(h);
       h.single_task<kernel<N>>(
           [=]() { value_operations::assign(resultPtr[0], fun()); });
     });
+    sycl_cts::util::record_kernel_profile(event);
   } catch (const sycl::exception &e) {
     log_exception(log, e);
     std::string errorMsg = "tests case: " + std::to_string(N) +
@@ -175,6 +178,202 @@ void check_function(sycl_cts::util::logger &log, funT fun,
          "tests case: " + std::to_string(N) + ". Correctness check failed.");
 }
 
+/**
+ * @brief Single case of a batched math builtin check
+ * @tparam N Id of the generated test case, used for failure reporting
+ */
+template <int N, typename returnT, typename funT>
+struct batch_case {
+  static constexpr int id = N;
+  using return_type = returnT;
+
+  funT fun;
+  sycl_cts::resultRef<returnT> ref;
+  int accuracy;
+  std::string comment;
+};
+
+template <int N, typename returnT, typename funT>
+batch_case<N, returnT, funT> make_batch_case(
+    funT fun, sycl_cts::resultRef<returnT> ref, int accuracy = 0,
+    const std::string &comment = {}) {
+  return {fun, ref, accuracy, comment};
+}
+
+/**
+ * @brief Trivially copyable storage for the results of all cases in a batch,
+ *        so that a single buffer element can hold them
+ */
+template <typename... Ts>
+struct batch_results {};
+
+template <typename T, typename... Ts>
+struct batch_results<T, Ts...> {
+  T head;
+  batch_results<Ts...> tail;
+};
+
+template <typename resultsT>
+void assign_batch_results(resultsT &) {}
+
+template <typename resultsT, typename funT, typename... funTs>
+void assign_batch_results(resultsT &results, const funT &fun,
+                          const funTs &... funs) {
+  value_operations::assign(results.head, fun());
+  assign_batch_results(results.tail, funs...);
+}
+
+template <typename resultsT>
+void verify_batch_results(sycl_cts::util::logger &, const resultsT &,
+                          std::string &) {}
+
+template <typename resultsT, typename caseT, typename... caseTs>
+void verify_batch_results(sycl_cts::util::logger &log,
+                          const resultsT &results, std::string &failedCases,
+                          const caseT &testCase, const caseTs &... cases) {
+  if (!verify(log, results.head, testCase.ref, testCase.accuracy,
+              testCase.comment)) {
+    if (!failedCases.empty()) failedCases += ", ";
+    failedCases += std::to_string(caseT::id);
+  }
+  verify_batch_results(log, results.tail, failedCases, cases...);
+}
+
+template <int N, typename resultsT, typename... funTs>
+void run_batch_kernel(resultsT &kernelResults, funTs... funs) {
+  auto &&testQueue = once_per_unit::get_queue();
+  sycl::buffer<resultsT, 1> buffer(&kernelResults, sycl::range<1>(1));
+  const auto event = testQueue.submit([&](sycl::handler &h) {
+    auto resultPtr = buffer.template get_access<sycl::access_mode::write>(h);
+    h.single_task<kernel<N>>(
+        [=]() { assign_batch_results(resultPtr[0], funs...); });
+  });
+  sycl_cts::util::record_kernel_profile(event);
+}
+
+/**
+ * @brief Runs several generated math builtin cases in a single kernel and
+ *        verifies every result on the host
+ * @tparam N Id of the batch; matches the id of its first case
+ */
+template <int N, typename... caseTs>
+void check_function_batch(sycl_cts::util::logger &log,
+                          const caseTs &... cases) {
+  batch_results<typename caseTs::return_type...> kernelResults;
+  try {
+    run_batch_kernel<N>(kernelResults, cases.fun...);
+  } catch (const sycl::exception &e) {
+    log_exception(log, e);
+    std::string errorMsg = "tests batch: " + std::to_string(N) +
+                           " a SYCL exception was caught: " + e.what();
+    FAIL(log, errorMsg.c_str());
+  }
+
+  std::string failedCases;
+  verify_batch_results(log, kernelResults, failedCases, cases...);
+  if (!failedCases.empty())
+    FAIL(log, "tests cases: " + failedCases + ". Correctness check failed.");
+}
+
+/** Number of failing samples of a sweep that are logged before giving up */
+constexpr size_t max_reported_sweep_failures = 8;
+
+template <int N, typename returnT, typename funT, typename... argTs>
+void run_sweep_kernel(funT fun, size_t count, returnT *results,
+                      argTs *... inputs) {
+  const sycl::range<1> range(count);
+  sycl::buffer<returnT, 1> resultBuffer(results, range);
+  auto argBuffers = std::make_tuple(sycl::buffer<argTs, 1>(inputs, range)...);
+  const auto event = once_per_unit::get_queue().submit([&](sycl::handler &h) {
+    auto resultPtr =
+        resultBuffer.template get_access<sycl::access_mode::write>(h);
+    std::apply(
+        [&](auto &... buffers) {
+          auto launch = [&](auto... argPtrs) {
+            h.parallel_for<kernel<N>>(range, [=](sycl::id<1> i) {
+              value_operations::assign(resultPtr[i], fun(argPtrs[i]...));
+            });
+          };
+          launch(buffers.template get_access<sycl::access_mode::read>(h)...);
+        },
+        argBuffers);
+  });
+  sycl_cts::util::record_kernel_profile(event);
+}
+
+/**
+ * @brief Checks a math builtin with randomized inputs read from a device
+ *        buffer instead of a single set of inputs compiled into the kernel
+ *
+ * The number of inputs and their seed are taken from the `--math-samples`
+ * and `--math-seed` CLI parameters, so coverage can be increased without
+ * rebuilding the test.
+ * @tparam N Id of the generated test case, also used for seeding
+ * @tparam argTs Argument types of the math builtin
+ * @param fun Calls the math builtin on the device
+ * @param refFun Calls the reference implementation on the host
+ * @param domain Inputs the math builtin is defined and accurate for
+ */
+template <int N, typename returnT, typename... argTs, typename funT,
+          typename refFunT>
+void check_function_sweep(sycl_cts::util::logger &log, funT fun,
+                          refFunT refFun,
+                          const sycl_cts::math::sweep_domain &domain = {},
+                          int accuracy = 0, const std::string &comment = {}) {
+  const auto &config =
+      sycl_cts::util::get<sycl_cts::util::math_sweep_config>();
+  const size_t samples = config.samples();
+  if (samples == 0) return;
+
+  sycl_cts::math::sweep_rng rng(config.seed(), N);
+  // Braced initialization guarantees that the inputs are generated in order
+  std::tuple<std::unique_ptr<argTs[]>...> inputs{
+      sycl_cts::math::make_sweep_inputs<argTs>(rng, samples, domain)...};
+  std::apply(
+      [&](auto &... in) {
+        sycl_cts::math::order_sweep_inputs(domain, samples, in.get()...);
+      },
+      inputs);
+
+  std::unique_ptr<returnT[]> kernelResults(new returnT[samples]);
+  try {
+    std::apply(
+        [&](auto &... in) {
+          run_sweep_kernel<N>(fun, samples, kernelResults.get(), in.get()...);
+        },
+        inputs);
+  } catch (const sycl::exception &e) {
+    log_exception(log, e);
+    std::string errorMsg = "tests case: " + std::to_string(N) +
+                           " a SYCL exception was caught: " + e.what();
+    FAIL(log, errorMsg.c_str());
+  }
+
+  std::vector<sycl_cts::resultRef<returnT>> refs(samples);
+  std::apply(
+      [&](const auto &... in) {
+        sycl_cts::math::evaluate_reference_batch<returnT>(
+            refFun, samples, refs.data(), in.get()...);
+      },
+      inputs);
+
+  std::string failedSamples;
+  size_t failures = 0;
+  for (size_t i = 0; i < samples && failures < max_reported_sweep_failures;
+       ++i) {
+    if (!verify(log, kernelResults[i], refs[i], accuracy, comment)) {
+      if (!failedSamples.empty()) failedSamples += ", ";
+      failedSamples += std::to_string(i);
+      ++failures;
+    }
+  }
+  if (failures != 0)
+    FAIL(log, "tests case: " + std::to_string(N) +
+                  ". Correctness check failed for samples: " + failedSamples +
+                  " (--math-seed " + std::to_string(config.seed()) +
+                  " --math-samples " + std::to_string(samples) + ")");
+}
+
 template <int N, typename returnT, typename funT, typename argT>
 void check_function_multi_ptr_private(sycl_cts::util::logger &log, funT fun,
                                       sycl_cts::resultRef<returnT> ref,
@@ -187,7 +386,7 @@ void check_function_multi_ptr_private(sycl_cts::util::logger &log, funT fun,
   try {
     sycl::buffer<returnT, 1> buffer(&kernelResult, ndRng);
     sycl::buffer<argT, 1> bufferArg(&kernelResultArg, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr =
           buffer.template get_access<sycl::access_mode::write>(h);
       auto resultPtrArg =
@@ -198,6 +397,7 @@ void check_function_multi_ptr_private(sycl_cts::util::logger &log, funT fun,
         resultPtrArg[0] = result.resArg;
       });
     });
+    sycl_cts::util::record_kernel_profile(event);
   } catch (const sycl::exception &e) {
     log_exception(log, e);
     std::string errorMsg = "tests case: " + std::to_string(N) +
@@ -224,7 +424,7 @@ void check_function_multi_ptr_global(sycl_cts::util::logger &log, funT fun,
   try {
     sycl::buffer<returnT, 1> buffer(&kernelResult, ndRng);
     sycl::buffer<argT, 1> ptrBuffer(&arg, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr =
           buffer.template get_access<sycl::access_mode::write>(h);
       sycl::accessor<argT, 1, sycl::access_mode::read_write,
@@ -232,6 +432,7 @@ void check_function_multi_ptr_global(sycl_cts::util::logger &log, funT fun,
           globalAccessor(ptrBuffer, h);
       h.single_task<kernel<N>>([=]() { resultPtr[0] = fun(globalAccessor); });
     });
+    sycl_cts::util::record_kernel_profile(event);
   } catch (const sycl::exception &e) {
     log_exception(log, e);
     std::string errorMsg = "tests case: " + std::to_string(N) +
@@ -258,7 +459,7 @@ void check_function_multi_ptr_local(sycl_cts::util::logger &log, funT fun,
   try {
     sycl::buffer<returnT, 1> buffer(&kernelResult, ndRng);
     sycl::buffer<argT, 1> bufferArg(&arg, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr =
           buffer.template get_access<sycl::access_mode::write>(h);
       auto resultPtrArg =
@@ -272,6 +473,7 @@ void check_function_multi_ptr_local(sycl_cts::util::logger &log, funT fun,
             resultPtrArg[0] = localAccessor[0];
           });
     });
+    sycl_cts::util::record_kernel_profile(event);
   } catch (const sycl::exception &e) {
     log_exception(log, e);
     std::string errorMsg = "tests case: " + std::to_string(N) +
@@ -294,12 +496,13 @@ void test_function(funT fun) {
   auto&& testQueue = once_per_unit::get_queue();
   {
     sycl::buffer<returnT, 1> buffer(kernelResult, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr = buffer.template get_access<sycl::access_mode::write>(h);
         h.single_task<kernel<T>>([=](){
           resultPtr[0] = fun();
         });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
   testQueue.wait_and_throw();
   delete[] kernelResult;
@@ -313,13 +516,14 @@ void test_function_multi_ptr_global(funT fun, argT arg) {
   {
     sycl::buffer<returnT, 1> buffer(kernelResult, ndRng);
     sycl::buffer<argT, 1> ptrBuffer(&arg, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr = buffer.template get_access<sycl::access_mode::write>(h);
       sycl::accessor<argT, 1, sycl::access_mode::read_write, sycl::target::device> globalAccessor(ptrBuffer, h);
         h.single_task<kernel<T>>([=](){
           resultPtr[0] = fun(globalAccessor);
         });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
   testQueue.wait_and_throw();
   delete[] kernelResult;
@@ -332,7 +536,7 @@ void test_function_multi_ptr_local(funT fun, argT arg) {
   auto&& testQueue = once_per_unit::get_queue();
   {
     sycl::buffer<returnT, 1> buffer(kernelResult, ndRng);
-    testQueue.submit([&](sycl::handler &h) {
+    const auto event = testQueue.submit([&](sycl::handler &h) {
       auto resultPtr = buffer.template get_access<sycl::access_mode::write>(h);
       sycl::accessor<argT, 1, sycl::access_mode::read_write, sycl::target::local> localAccessor(1, h);
         h.single_task<kernel<T>>([arg, localAccessor, resultPtr, fun](){
@@ -340,6 +544,7 @@ void test_function_multi_ptr_local(funT fun, argT arg) {
           resultPtr[0] = fun(localAccessor);
         });
     });
+    sycl_cts::util::record_kernel_profile(event);
   }
   testQueue.wait_and_throw();
   delete[] kernelResult;
@@ -77,6 +77,62 @@ test_case_templates_check = {
 """)
 }
 
+# Templates used when several "no_ptr" cases are checked by a single kernel.
+# Each case computes its reference in its own scope so that the generated
+# argument names do not clash between cases of the same batch.
+batch_case_template = ("""
+  auto case_$TEST_ID = [&] {
+    $REFERENCE
+    return make_batch_case<$TEST_ID, $RETURN_TYPE>(
+        [=]{
+          $FUNCTION_CALL
+        }, ref$ACCURACY$COMMENT);
+  }();
+""")
+
+batch_template = Template("""
+{
+${cases}
+  check_function_batch<${batch_id}>(log, ${case_names});
+}
+""")
+
+# Template used when a test case without pointer arguments is checked with
+# randomized inputs that are generated at runtime and read from a buffer, see
+# check_function_sweep() in math_builtin.h.
+sweep_case_template = ("""
+{
+  check_function_sweep<$TEST_ID, $RETURN_TYPE$ARG_TYPES>(log,
+      []($PARAMS){
+        $FUNCTION_CALL
+      },
+      []($PARAMS){
+        return $REFERENCE_CALL;
+      }, $DOMAIN$ACCURACY$COMMENT);
+}
+""")
+
+# Inputs of the swept builtins whose results are undefined or inaccurate for
+# most random bit patterns, see sweep_domain in util/math_sweep.h. Keyed by
+# namespace and name; all other builtins are swept over the full range.
+sweep_domains = {
+    # Only defined for inputs in [-2^16, 2^16]
+    ("sycl::half_precision", "sin"): "sycl_cts::math::sweep_domain::bounded(-0x1p16, 0x1p16)",
+    ("sycl::half_precision", "cos"): "sycl_cts::math::sweep_domain::bounded(-0x1p16, 0x1p16)",
+    ("sycl::half_precision", "tan"): "sycl_cts::math::sweep_domain::bounded(-0x1p16, 0x1p16)",
+    # Undefined if minval > maxval
+    ("sycl", "clamp"): "sycl_cts::math::sweep_domain::ordered(1, 2)",
+    # Undefined if edge0 >= edge1
+    ("sycl", "smoothstep"): "sycl_cts::math::sweep_domain::ordered(0, 1)",
+    # Sums of products of mixed signs cancel, which makes the ulp bound
+    # meaningless. Positive inputs cannot cancel, and the lower bound keeps
+    # their products normal.
+    ("sycl", "dot"): "sycl_cts::math::sweep_domain::bounded(0x1p-32, 0x1p32)",
+    # The differences of products in cross cancel for any choice of signs, so
+    # small integers are used, whose products and differences are exact
+    ("sycl", "cross"): "sycl_cts::math::sweep_domain::integers_in(-2048, 2048)",
+}
+
 def generate_value(base_type, dim):
     val = ""
     for i in range(dim):
@@ -215,9 +271,24 @@ def generate_reference_ptr(types, sig, arg_names, arg_src):
     return fc
 
 def generate_test_case(test_id, types, sig, memory, check):
-    testCaseSource = test_case_templates_check[memory] if check else test_case_templates[memory]
+    if memory == "sweep":
+        testCaseSource = sweep_case_template
+        # The arguments are lambda parameters instead of generated values
+        arg_names = ["inputData_" + str(i) for i in range(len(sig.arg_types))]
+        arg_src = ""
+        testCaseSource = testCaseSource.replace("$ARG_TYPES", "".join([", " + arg.name for arg in sig.arg_types]))
+        testCaseSource = testCaseSource.replace("$PARAMS", ", ".join([arg.name + " " + name for (arg, name) in zip(sig.arg_types, arg_names)]))
+        testCaseSource = testCaseSource.replace("$REFERENCE_CALL", "reference::" + sig.name + "(" + ", ".join(arg_names) + ")")
+        testCaseSource = testCaseSource.replace("$DOMAIN", sweep_domains.get((sig.namespace, sig.name), "{}"))
+        memory = "no_ptr"
+    else:
+        if memory == "batch":
+            testCaseSource = batch_case_template
+            memory = "no_ptr"
+        else:
+            testCaseSource = test_case_templates_check[memory] if check else test_case_templates[memory]
+        (arg_names, arg_src) = generate_arguments(sig, memory)
     testCaseId = str(test_id)
-    (arg_names, arg_src) = generate_arguments(sig, memory)
     testCaseSource = testCaseSource.replace("$REFERENCE", generate_reference(sig, arg_names, arg_src))
     testCaseSource = testCaseSource.replace("$PTR_REF", generate_reference_ptr(types, sig, arg_names, arg_src))
     testCaseSource = testCaseSource.replace("$TEST_ID", testCaseId)
@@ -253,25 +324,61 @@ def generate_test_case(test_id, types, sig, memory, check):
     testCaseSource = testCaseSource.replace("$FUNCTION_CALL", generate_function_call(sig, arg_names, arg_src))
     return testCaseSource
 
-def generate_test_cases(test_id, types, sig_list, check):
-    random.seed(0)
-    test_source = ""
+def generate_batch(batch):
+    """
+    Wraps a list of (test_id, case_source) pairs into a single batched check.
+    """
+    return batch_template.substitute(
+        cases="".join([case for (_, case) in batch]),
+        batch_id=str(batch[0][0]),
+        case_names=", ".join(["case_" + str(case_id) for (case_id, _) in batch]))
+
+def generate_test_case_blocks(test_id, types, sig_list, check, batch_size=1, sweep=False, seed=0):
+    """
+    Generates the test cases as a list of independent source blocks, each of
+    them either a single test case or a batch of test cases. With sweep,
+    test cases without pointer arguments are checked with randomized inputs
+    generated at runtime instead. The generated values only depend on seed,
+    so the output is identical between runs.
+    """
+    random.seed(seed)
+    blocks = []
+    batch = []
     for sig in sig_list:
+        if check and sweep and not sig.pntr_indx:
+            blocks.append(generate_test_case(test_id, types, sig, "sweep", check))
+            test_id += 1
+            continue
+        if check and batch_size > 1 and not sig.pntr_indx:
+            batch.append((test_id, generate_test_case(test_id, types, sig, "batch", check)))
+            test_id += 1
+            if len(batch) == batch_size:
+                blocks.append(generate_batch(batch))
+                batch = []
+            continue
+        if batch:
+            blocks.append(generate_batch(batch))
+            batch = []
         if sig.pntr_indx:#If the signature contains a pointer argument.
-            test_source += generate_test_case(test_id, types, sig, "private", check)
+            blocks.append(generate_test_case(test_id, types, sig, "private", check))
             test_id += 1
-            test_source += generate_test_case(test_id, types, sig, "local", check)
+            blocks.append(generate_test_case(test_id, types, sig, "local", check))
             test_id += 1
-            test_source += generate_test_case(test_id, types, sig, "global", check)
+            blocks.append(generate_test_case(test_id, types, sig, "global", check))
             test_id += 1
         else:
             if check:
-                test_source += generate_test_case(test_id, types, sig, "no_ptr", check)
+                blocks.append(generate_test_case(test_id, types, sig, "no_ptr", check))
                 test_id += 1
             else:
-                test_source += generate_test_case(test_id, types, sig, "private", check)
+                blocks.append(generate_test_case(test_id, types, sig, "private", check))
                 test_id += 1
-    return test_source
+    if batch:
+        blocks.append(generate_batch(batch))
+    return blocks
+
+def generate_test_cases(test_id, types, sig_list, check, batch_size=1, sweep=False, seed=0):
+    return "".join(generate_test_case_blocks(test_id, types, sig_list, check, batch_size, sweep, seed))
 
 # Lists of the types with equal sizes
 chars = ["char", "signed char", "unsigned char"]
@@ -0,0 +1,306 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides atomic_ref contention benchmarks for memory orders, memory scopes
+//  and address spaces
+//
+*******************************************************************************/
+
+#include "../common/disabled_for_test_case.h"
+#include "catch2/catch_test_macros.hpp"
+
+#if !SYCL_CTS_COMPILING_WITH_HIPSYCL && !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+
+#include "../atomic_ref/atomic_ref_common.h"
+#include "../common/benchmark.h"
+
+#endif  // !SYCL_CTS_COMPILING_WITH_HIPSYCL &&
+        // !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+
+namespace perf_atomic {
+#if !SYCL_CTS_COMPILING_WITH_HIPSYCL && !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+using namespace atomic_ref::tests::common;
+
+/** Number of work-items of every benchmark kernel */
+constexpr size_t global_size = 64 * 1024;
+
+/** Largest work-group size used, smaller if the device requires it */
+constexpr size_t max_work_group_size = 256;
+
+/** Number of atomic operations each work-item performs */
+constexpr size_t iterations = 16;
+
+/** Number of locations of the few_locations access pattern */
+constexpr size_t few_locations = 8;
+
+/** Distance between the locations of the strided pattern, in elements */
+constexpr size_t stride = 16;
+
+enum class atomic_op { fetch_add, compare_exchange, exchange, fetch_min_max };
+
+/** @brief Locations the work-items of a work-group, or of the whole kernel
+ *         for device and system scope in global memory, operate on
+ */
+enum class access_pattern { one_location, few_locations, strided_locations };
+
+template <typename T, typename MemoryOrderT, typename MemoryScopeT,
+          typename AddressSpaceT, atomic_op Op>
+class atomic_kernel;
+
+inline std::string op_name(atomic_op op) {
+  switch (op) {
+    case atomic_op::fetch_add:
+      return "fetch_add";
+    case atomic_op::compare_exchange:
+      return "compare_exchange_weak loop";
+    case atomic_op::exchange:
+      return "exchange";
+    case atomic_op::fetch_min_max:
+      return "fetch_min/fetch_max";
+  }
+  return {};
+}
+
+inline std::string pattern_name(access_pattern pattern) {
+  switch (pattern) {
+    case access_pattern::one_location:
+      return "one location";
+    case access_pattern::few_locations:
+      return std::to_string(few_locations) + " locations";
+    case access_pattern::strided_locations:
+      return "strided locations";
+  }
+  return {};
+}
+
+/** @brief Number of elements the given number of work-items operate on
+ */
+constexpr size_t pattern_extent(access_pattern pattern, size_t work_items) {
+  switch (pattern) {
+    case access_pattern::one_location:
+      return 1;
+    case access_pattern::few_locations:
+      return few_locations;
+    default:
+      return work_items * stride;
+  }
+}
+
+constexpr size_t pattern_index(access_pattern pattern, size_t id) {
+  switch (pattern) {
+    case access_pattern::one_location:
+      return 0;
+    case access_pattern::few_locations:
+      return id % few_locations;
+    default:
+      return id * stride;
+  }
+}
+
+/**
+ * @brief Memory scopes that are measured; contention between work-items is
+ *        only well-defined for scopes that include all of them, so the
+ *        work_item and sub_group scopes are not part of the benchmark
+ */
+inline auto get_contention_memory_scopes() {
+  static const auto memory_scopes =
+      value_pack<sycl::memory_scope, sycl::memory_scope::work_group,
+                 sycl::memory_scope::device,
+                 sycl::memory_scope::system>::generate_named();
+  return memory_scopes;
+}
+
+/** @brief Runs the atomic operation iterations times on the given location
+ *  @retval Value that depends on all results, to keep them alive
+ */
+template <atomic_op Op, typename AtomicRefT, typename T>
+T run_atomic_op(AtomicRefT a_r, T value) {
+  T result{};
+  for (size_t i = 0; i < iterations; ++i) {
+    if constexpr (Op == atomic_op::fetch_add) {
+      result ^= a_r.fetch_add(value);
+    } else if constexpr (Op == atomic_op::compare_exchange) {
+      T expected = a_r.load();
+      while (!a_r.compare_exchange_weak(expected, expected + value)) {
+      }
+      result ^= expected;
+    } else if constexpr (Op == atomic_op::exchange) {
+      result ^= a_r.exchange(value + static_cast<T>(i));
+    } else {
+      result ^= (i % 2) ? a_r.fetch_max(value) : a_r.fetch_min(value);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Measures the throughput of every atomic operation and access pattern
+ *        for one combination of type, memory order, memory scope and address
+ *        space
+ */
+template <typename T, typename MemoryOrderT, typename MemoryScopeT,
+          typename AddressSpaceT>
+class run_contention_benchmark {
+  static constexpr sycl::memory_order memory_order = MemoryOrderT::value;
+  static constexpr sycl::memory_scope memory_scope = MemoryScopeT::value;
+  static constexpr sycl::access::address_space address_space =
+      AddressSpaceT::value;
+  static constexpr bool in_local_memory =
+      address_space == sycl::access::address_space::local_space;
+  // Narrower scopes in global memory give every work-group its own locations
+  static constexpr bool per_work_group_locations =
+      in_local_memory || memory_scope == sycl::memory_scope::work_group;
+
+  using atomic_ref_type =
+      sycl::atomic_ref<T, memory_order, memory_scope, address_space>;
+
+  template <atomic_op Op>
+  sycl::event submit(sycl::queue& queue, access_pattern pattern, T* data,
+                     T* sink, size_t work_group_size) {
+    return queue.submit([&](sycl::handler& cgh) {
+      using kernel_name =
+          atomic_kernel<T, MemoryOrderT, MemoryScopeT, AddressSpaceT, Op>;
+      const sycl::nd_range<1> range{sycl::range<1>{global_size},
+                                    sycl::range<1>{work_group_size}};
+      const size_t group_extent = pattern_extent(pattern, work_group_size);
+
+      if constexpr (in_local_memory) {
+        sycl::local_accessor<T, 1> local_data(sycl::range<1>{group_extent},
+                                              cgh);
+        cgh.parallel_for<kernel_name>(range, [=](sycl::nd_item<1> item) {
+          const size_t lid = item.get_local_linear_id();
+          for (size_t i = lid; i < group_extent; i += work_group_size)
+            local_data[i] = T{};
+          sycl::group_barrier(item.get_group());
+
+          atomic_ref_type a_r(local_data[pattern_index(pattern, lid)]);
+          const T result = run_atomic_op<Op>(a_r, static_cast<T>(lid % 64));
+          if (result == static_cast<T>(-1)) *sink = result;
+        });
+      } else {
+        cgh.parallel_for<kernel_name>(range, [=](sycl::nd_item<1> item) {
+          size_t index = 0;
+          if constexpr (per_work_group_locations) {
+            index = item.get_group_linear_id() * group_extent +
+                    pattern_index(pattern, item.get_local_linear_id());
+          } else {
+            index = pattern_index(pattern, item.get_global_linear_id());
+          }
+          atomic_ref_type a_r(data[index]);
+          const T result = run_atomic_op<Op>(
+              a_r, static_cast<T>(item.get_global_linear_id() % 64));
+          if (result == static_cast<T>(-1)) *sink = result;
+        });
+      }
+    });
+  }
+
+  template <atomic_op Op>
+  void benchmark_op(sycl::queue& queue, T* data, T* sink,
+                    size_t work_group_size) {
+    const size_t local_mem_size =
+        queue.get_device().get_info<sycl::info::device::local_mem_size>();
+    for (auto pattern :
+         {access_pattern::one_location, access_pattern::few_locations,
+          access_pattern::strided_locations}) {
+      if (in_local_memory &&
+          pattern_extent(pattern, work_group_size) * sizeof(T) >
+              local_mem_size) {
+        continue;
+      }
+      benchmark::set_work(0, global_size * iterations);
+      BENCHMARK(op_name(Op) + ", " + pattern_name(pattern)) {
+        submit<Op>(queue, pattern, data, sink, work_group_size)
+            .wait_and_throw();
+      };
+    }
+  }
+
+ public:
+  void operator()(const std::string& type_name,
+                  const std::string& memory_order_name,
+                  const std::string& memory_scope_name,
+                  const std::string& address_space_name) {
+    auto queue = util::get_cts_object::queue();
+    if (memory_order_and_scope_are_not_supported(queue, memory_order,
+                                                 memory_scope)) {
+      return;
+    }
+
+    SECTION(get_section_name(type_name, memory_order_name, memory_scope_name,
+                             address_space_name, "Atomic contention")) {
+      const size_t work_group_size = std::min(
+          max_work_group_size,
+          queue.get_device()
+              .get_info<sycl::info::device::max_work_group_size>());
+      const size_t data_size =
+          pattern_extent(access_pattern::strided_locations, global_size);
+      T* data = sycl::malloc_device<T>(data_size, queue);
+      T* sink = sycl::malloc_device<T>(1, queue);
+      queue.memset(data, 0, data_size * sizeof(T)).wait_and_throw();
+
+      benchmark_op<atomic_op::fetch_add>(queue, data, sink, work_group_size);
+      benchmark_op<atomic_op::compare_exchange>(queue, data, sink,
+                                                work_group_size);
+      benchmark_op<atomic_op::exchange>(queue, data, sink, work_group_size);
+      benchmark_op<atomic_op::fetch_min_max>(queue, data, sink,
+                                             work_group_size);
+
+      sycl::free(data, queue);
+      sycl::free(sink, queue);
+    }
+  }
+};
+
+template <typename T>
+struct run_contention_benchmarks {
+  void operator()(const std::string& type_name) {
+    const auto memory_orders = get_memory_orders();
+    const auto memory_scopes = get_contention_memory_scopes();
+    const auto address_spaces = get_address_spaces();
+
+    for_all_combinations<run_contention_benchmark, T>(
+        memory_orders, memory_scopes, address_spaces, type_name);
+  }
+};
+#endif  // !SYCL_CTS_COMPILING_WITH_HIPSYCL &&
+        // !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+
+// FIXME: re-enable for computecpp when
+// sycl::access::address_space::generic_space is implemented in computecpp,
+// re-enable for hipsycl when
+// sycl::info::device::atomic_memory_order_capabilities and
+// sycl::info::device::atomic_memory_scope_capabilities are implemented in
+// hipsycl
+DISABLED_FOR_TEST_CASE(ComputeCpp, hipSYCL)
+("Atomic contention, 32-bit types", "[perf_atomic][benchmark][serial]")({
+  const auto types = named_type_pack<int>::generate("int");
+  for_all_types<run_contention_benchmarks>(types);
+});
+
+DISABLED_FOR_TEST_CASE(ComputeCpp, hipSYCL)
+("Atomic contention, 64-bit types", "[perf_atomic][benchmark][serial]")({
+  auto queue = sycl_cts::util::get_cts_object::queue();
+  if (!queue.get_device().has(sycl::aspect::atomic64)) {
+    SKIP("Device does not support 64-bit atomic operations");
+  }
+  const auto types = named_type_pack<long long>::generate("long long");
+  for_all_types<run_contention_benchmarks>(types);
+});
+
+}  // namespace perf_atomic
@@ -0,0 +1,491 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides throughput benchmarks for group algorithms and collectives
+//
+*******************************************************************************/
+
+#include "../common/benchmark.h"
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace perf_group_algorithms {
+using namespace sycl_cts;
+
+/** Work-group sizes to measure, larger ones are skipped if unsupported */
+constexpr size_t work_group_sizes[] = {64, 256, 1024};
+
+/** Total number of input elements of one kernel */
+constexpr size_t input_lengths[] = {size_t{1} << 16, size_t{1} << 20,
+                                    size_t{1} << 24};
+
+/** Number of elements per work-item the joint algorithms process */
+constexpr size_t joint_elements_per_work_item = 16;
+
+enum class collective {
+  joint_reduce,
+  joint_inclusive_scan,
+  joint_exclusive_scan,
+  reduce_over_work_group,
+  reduce_over_sub_group,
+  inclusive_scan_over_work_group,
+  inclusive_scan_over_sub_group,
+  exclusive_scan_over_work_group,
+  exclusive_scan_over_sub_group,
+  broadcast_work_group,
+  broadcast_sub_group,
+  permute_group_by_xor,
+  shift_group_left,
+  shift_group_right
+};
+
+inline std::string collective_name(collective op) {
+  switch (op) {
+    case collective::joint_reduce:
+      return "joint_reduce";
+    case collective::joint_inclusive_scan:
+      return "joint_inclusive_scan";
+    case collective::joint_exclusive_scan:
+      return "joint_exclusive_scan";
+    case collective::reduce_over_work_group:
+      return "reduce_over_group(group)";
+    case collective::reduce_over_sub_group:
+      return "reduce_over_group(sub_group)";
+    case collective::inclusive_scan_over_work_group:
+      return "inclusive_scan_over_group(group)";
+    case collective::inclusive_scan_over_sub_group:
+      return "inclusive_scan_over_group(sub_group)";
+    case collective::exclusive_scan_over_work_group:
+      return "exclusive_scan_over_group(group)";
+    case collective::exclusive_scan_over_sub_group:
+      return "exclusive_scan_over_group(sub_group)";
+    case collective::broadcast_work_group:
+      return "group_broadcast(group)";
+    case collective::broadcast_sub_group:
+      return "group_broadcast(sub_group)";
+    case collective::permute_group_by_xor:
+      return "permute_group_by_xor";
+    case collective::shift_group_left:
+      return "shift_group_left";
+    case collective::shift_group_right:
+      return "shift_group_right";
+  }
+  return {};
+}
+
+constexpr bool is_joint(collective op) {
+  return op == collective::joint_reduce ||
+         op == collective::joint_inclusive_scan ||
+         op == collective::joint_exclusive_scan;
+}
+
+template <typename T, collective Op, size_t SubGroupSize>
+class collective_kernel;
+
+template <size_t SubGroupSize>
+class layout_kernel;
+
+/** @brief Input element i. The non-zero elements are sparse and small, so that
+ *         all sums are exact integers, even for sycl::half, and results can be
+ *         compared exactly regardless of the order of the operations
+ */
+template <typename T>
+T input_value(size_t i) {
+  return static_cast<T>(static_cast<int>(i % 32 == 0 ? 1 + (i / 32) % 3 : 0));
+}
+
+/** @brief Whether the collective operates on sub-groups */
+constexpr bool is_over_sub_group(collective op) {
+  return op == collective::reduce_over_sub_group ||
+         op == collective::inclusive_scan_over_sub_group ||
+         op == collective::exclusive_scan_over_sub_group ||
+         op == collective::broadcast_sub_group ||
+         op == collective::permute_group_by_xor ||
+         op == collective::shift_group_left ||
+         op == collective::shift_group_right;
+}
+
+/** @brief Applies the collective to the element of the work-item, or to the
+ *         segment of the work-group for the joint algorithms
+ *  @param segment Number of elements each work-group processes with the joint
+ *         algorithms
+ */
+template <typename T, collective Op>
+void apply(const sycl::nd_item<1>& item, const T* in, T* out, size_t segment) {
+  const auto group = item.get_group();
+  const auto sub_group = item.get_sub_group();
+  const sycl::plus<T> op;
+
+  if constexpr (is_joint(Op)) {
+    const size_t offset = group.get_group_linear_id() * segment;
+    const T* first = in + offset;
+    const T* last = first + segment;
+    if constexpr (Op == collective::joint_reduce) {
+      const T result = sycl::joint_reduce(group, first, last, T{}, op);
+      if (group.leader()) out[group.get_group_linear_id()] = result;
+    } else if constexpr (Op == collective::joint_inclusive_scan) {
+      sycl::joint_inclusive_scan(group, first, last, out + offset, op);
+    } else {
+      sycl::joint_exclusive_scan(group, first, last, out + offset, op);
+    }
+  } else {
+    const size_t id = item.get_global_linear_id();
+    const T x = in[id];
+    T result;
+    if constexpr (Op == collective::reduce_over_work_group) {
+      result = sycl::reduce_over_group(group, x, op);
+    } else if constexpr (Op == collective::reduce_over_sub_group) {
+      result = sycl::reduce_over_group(sub_group, x, op);
+    } else if constexpr (Op == collective::inclusive_scan_over_work_group) {
+      result = sycl::inclusive_scan_over_group(group, x, op);
+    } else if constexpr (Op == collective::inclusive_scan_over_sub_group) {
+      result = sycl::inclusive_scan_over_group(sub_group, x, op);
+    } else if constexpr (Op == collective::exclusive_scan_over_work_group) {
+      result = sycl::exclusive_scan_over_group(group, x, op);
+    } else if constexpr (Op == collective::exclusive_scan_over_sub_group) {
+      result = sycl::exclusive_scan_over_group(sub_group, x, op);
+    } else if constexpr (Op == collective::broadcast_work_group) {
+      result = sycl::group_broadcast(group, x);
+    } else if constexpr (Op == collective::broadcast_sub_group) {
+      result = sycl::group_broadcast(sub_group, x);
+    } else if constexpr (Op == collective::permute_group_by_xor) {
+      result = sycl::permute_group_by_xor(sub_group, x, 1);
+    } else if constexpr (Op == collective::shift_group_left) {
+      result = sycl::shift_group_left(sub_group, x, 1);
+    } else {
+      result = sycl::shift_group_right(sub_group, x, 1);
+    }
+    out[id] = result;
+  }
+}
+
+/** @brief Submits the collective kernel
+ *  @tparam SubGroupSize Required sub-group size, 0 lets the implementation
+ *          choose it
+ */
+template <typename T, collective Op, size_t SubGroupSize>
+sycl::event submit(sycl::queue& queue, const T* in, T* out,
+                   size_t global_size, size_t work_group_size,
+                   size_t segment) {
+  return queue.submit([&](sycl::handler& cgh) {
+    using kernel_name = collective_kernel<T, Op, SubGroupSize>;
+    const sycl::nd_range<1> range{sycl::range<1>{global_size},
+                                  sycl::range<1>{work_group_size}};
+    if constexpr (SubGroupSize == 0) {
+      cgh.parallel_for<kernel_name>(range, [=](sycl::nd_item<1> item) {
+        apply<T, Op>(item, in, out, segment);
+      });
+    } else {
+      cgh.parallel_for<kernel_name>(
+          range, [=](sycl::nd_item<1> item)
+                     [[sycl::reqd_sub_group_size(SubGroupSize)]] {
+                       apply<T, Op>(item, in, out, segment);
+                     });
+    }
+  });
+}
+
+/** @brief Position of every work-item in its sub-group, as reported by the
+ *         device for the given sub-group size
+ */
+struct sub_group_layout {
+  /** Index of the sub-group of each work-item, unique across work-groups */
+  std::vector<size_t> subGroup;
+  /** Local id of each work-item in its sub-group */
+  std::vector<size_t> localId;
+};
+
+template <size_t SubGroupSize>
+sub_group_layout get_sub_group_layout(sycl::queue& queue, size_t global_size,
+                                      size_t work_group_size) {
+  sub_group_layout layout{std::vector<size_t>(global_size),
+                          std::vector<size_t>(global_size)};
+  {
+    sycl::buffer<size_t, 1> subGroupBuf(layout.subGroup.data(),
+                                        sycl::range<1>(global_size));
+    sycl::buffer<size_t, 1> localIdBuf(layout.localId.data(),
+                                       sycl::range<1>(global_size));
+    queue.submit([&](sycl::handler& cgh) {
+      auto subGroup = subGroupBuf.get_access<sycl::access_mode::write>(cgh);
+      auto localId = localIdBuf.get_access<sycl::access_mode::write>(cgh);
+      const auto record = [=](const sycl::nd_item<1>& item) {
+        const auto sub_group = item.get_sub_group();
+        const size_t id = item.get_global_linear_id();
+        subGroup[id] = item.get_group_linear_id() *
+                           sub_group.get_group_linear_range() +
+                       sub_group.get_group_linear_id();
+        localId[id] = sub_group.get_local_linear_id();
+      };
+      const sycl::nd_range<1> range{sycl::range<1>{global_size},
+                                    sycl::range<1>{work_group_size}};
+      if constexpr (SubGroupSize == 0) {
+        cgh.parallel_for<layout_kernel<SubGroupSize>>(
+            range, [=](sycl::nd_item<1> item) { record(item); });
+      } else {
+        cgh.parallel_for<layout_kernel<SubGroupSize>>(
+            range, [=](sycl::nd_item<1> item)
+                       [[sycl::reqd_sub_group_size(SubGroupSize)]] {
+                         record(item);
+                       });
+      }
+    });
+  }
+  return layout;
+}
+
+/** @brief Computes the expected output of the collective on the host and
+ *         compares it with out
+ *  @param members Global ids of the work-items of each group the collective
+ *         works on, ordered by their local id
+ *  @return Index of the first mismatching output element, or std::nullopt
+ */
+template <typename T, collective Op>
+std::optional<size_t> find_mismatch(
+    const std::vector<T>& in, const std::vector<T>& out,
+    const std::vector<std::vector<size_t>>& members) {
+  for (const auto& group : members) {
+    T total = static_cast<T>(0);
+    for (size_t id : group) total += in[id];
+    T prefix = static_cast<T>(0);
+    for (size_t local = 0; local < group.size(); ++local) {
+      const size_t id = group[local];
+      std::optional<T> expected;
+      if constexpr (Op == collective::reduce_over_work_group ||
+                    Op == collective::reduce_over_sub_group) {
+        expected = total;
+      } else if constexpr (Op == collective::inclusive_scan_over_work_group ||
+                           Op == collective::inclusive_scan_over_sub_group) {
+        prefix += in[id];
+        expected = prefix;
+      } else if constexpr (Op == collective::exclusive_scan_over_work_group ||
+                           Op == collective::exclusive_scan_over_sub_group) {
+        expected = prefix;
+        prefix += in[id];
+      } else if constexpr (Op == collective::broadcast_work_group ||
+                           Op == collective::broadcast_sub_group) {
+        expected = in[group[0]];
+      } else if constexpr (Op == collective::permute_group_by_xor) {
+        if ((local ^ 1) < group.size()) expected = in[group[local ^ 1]];
+      } else if constexpr (Op == collective::shift_group_left) {
+        if (local + 1 < group.size()) expected = in[group[local + 1]];
+      } else {
+        if (local > 0) expected = in[group[local - 1]];
+      }
+      // Results of work-items without a source in the group are unspecified
+      if (expected && !(out[id] == *expected)) return id;
+    }
+  }
+  return std::nullopt;
+}
+
+/** @brief Computes the expected output of a joint algorithm on the host and
+ *         compares it with out
+ *  @return Index of the first mismatching output element, or std::nullopt
+ */
+template <typename T, collective Op>
+std::optional<size_t> find_joint_mismatch(const std::vector<T>& in,
+                                          const std::vector<T>& out,
+                                          size_t groups, size_t segment) {
+  for (size_t g = 0; g < groups; ++g) {
+    T prefix = static_cast<T>(0);
+    for (size_t k = 0; k < segment; ++k) {
+      const size_t i = g * segment + k;
+      if constexpr (Op == collective::joint_exclusive_scan) {
+        if (!(out[i] == prefix)) return i;
+      }
+      prefix += in[i];
+      if constexpr (Op == collective::joint_inclusive_scan) {
+        if (!(out[i] == prefix)) return i;
+      }
+    }
+    if constexpr (Op == collective::joint_reduce) {
+      if (!(out[g] == prefix)) return g;
+    }
+  }
+  return std::nullopt;
+}
+
+/** @brief Runs the collective once and compares its output with the result
+ *         computed on the host, so that a miscompiled collective is not
+ *         reported as a throughput
+ */
+template <typename T, collective Op, size_t SubGroupSize>
+bool check_collective(sycl::queue& queue, const std::vector<T>& host_input,
+                      const T* in, T* out, size_t global_size,
+                      size_t work_group_size, size_t segment) {
+  const size_t length =
+      is_joint(Op) ? global_size * joint_elements_per_work_item : global_size;
+  queue.fill(out, static_cast<T>(-1), length).wait_and_throw();
+  submit<T, Op, SubGroupSize>(queue, in, out, global_size, work_group_size,
+                              segment)
+      .wait_and_throw();
+  std::vector<T> result(length);
+  queue.copy(out, result.data(), length).wait_and_throw();
+
+  std::optional<size_t> mismatch;
+  if constexpr (is_joint(Op)) {
+    mismatch = find_joint_mismatch<T, Op>(
+        host_input, result, global_size / work_group_size, segment);
+  } else {
+    std::vector<std::vector<size_t>> members;
+    if constexpr (is_over_sub_group(Op)) {
+      const auto layout = get_sub_group_layout<SubGroupSize>(
+          queue, global_size, work_group_size);
+      for (size_t id = 0; id < global_size; ++id) {
+        const size_t group = layout.subGroup[id];
+        const size_t local = layout.localId[id];
+        if (members.size() <= group) members.resize(group + 1);
+        if (members[group].size() <= local) members[group].resize(local + 1);
+        members[group][local] = id;
+      }
+    } else {
+      members.resize(global_size / work_group_size);
+      for (size_t id = 0; id < global_size; ++id)
+        members[id / work_group_size].push_back(id);
+    }
+    mismatch = find_mismatch<T, Op>(host_input, result, members);
+  }
+  if (mismatch) {
+    UNSCOPED_INFO("first wrong result at index " << *mismatch);
+    return false;
+  }
+  return true;
+}
+
+template <typename T, collective Op, size_t SubGroupSize>
+void benchmark_collective(sycl::queue& queue,
+                          const std::vector<T>& host_input, const T* in,
+                          T* out) {
+  const auto device = queue.get_device();
+  if constexpr (SubGroupSize != 0) {
+    const auto sizes = device.get_info<sycl::info::device::sub_group_sizes>();
+    if (std::find(sizes.begin(), sizes.end(), SubGroupSize) == sizes.end())
+      return;
+  }
+  const size_t max_work_group_size =
+      device.get_info<sycl::info::device::max_work_group_size>();
+  const std::string sub_group_name =
+      SubGroupSize == 0 ? "default" : std::to_string(SubGroupSize);
+
+  for (size_t work_group_size : work_group_sizes) {
+    if (work_group_size > max_work_group_size) break;
+    for (size_t length : input_lengths) {
+      size_t global_size = length;
+      size_t segment = 0;
+      if constexpr (is_joint(Op)) {
+        global_size = length / joint_elements_per_work_item;
+        segment = work_group_size * joint_elements_per_work_item;
+      }
+
+      const std::string name =
+          collective_name(Op) + ", work-group size " +
+          std::to_string(work_group_size) + ", sub-group size " +
+          sub_group_name + ", " + std::to_string(length) + " elements";
+      if (!check_collective<T, Op, SubGroupSize>(queue, host_input, in, out,
+                                                 global_size, work_group_size,
+                                                 segment)) {
+        FAIL_CHECK(name + " computed wrong results, not benchmarking it");
+        continue;
+      }
+
+      benchmark::set_work(length * sizeof(T), length);
+      BENCHMARK(std::string(name)) {
+        submit<T, Op, SubGroupSize>(queue, in, out, global_size,
+                                    work_group_size, segment)
+            .wait_and_throw();
+      };
+    }
+  }
+}
+
+/** @brief Benchmarks the collective with the implementation-chosen
+ *         sub-group size and every required sub-group size the device supports
+ */
+template <typename T, collective Op>
+void benchmark_all_sub_group_sizes(sycl::queue& queue,
+                                   const std::vector<T>& host_input,
+                                   const T* in, T* out) {
+  benchmark_collective<T, Op, 0>(queue, host_input, in, out);
+  benchmark_collective<T, Op, 8>(queue, host_input, in, out);
+  benchmark_collective<T, Op, 16>(queue, host_input, in, out);
+  benchmark_collective<T, Op, 32>(queue, host_input, in, out);
+}
+
+/** @brief Allocates input and output of the longest input length and runs
+ *         the given collectives
+ */
+template <typename T, collective... Ops>
+void run_collectives() {
+  auto queue = util::get_cts_object::queue();
+  if (!queue.get_device().has(sycl::aspect::usm_device_allocations)) {
+    SKIP("Device does not support USM device allocations");
+  }
+  if constexpr (std::is_same_v<T, sycl::half>) {
+    if (!queue.get_device().has(sycl::aspect::fp16)) {
+      SKIP("Device does not support sycl::half");
+    }
+  }
+  const size_t max_length = input_lengths[std::size(input_lengths) - 1];
+  std::vector<T> host_input(max_length);
+  for (size_t i = 0; i < max_length; ++i) host_input[i] = input_value<T>(i);
+
+  T* in = sycl::malloc_device<T>(max_length, queue);
+  T* out = sycl::malloc_device<T>(max_length, queue);
+  queue.copy(host_input.data(), in, max_length).wait_and_throw();
+
+  (benchmark_all_sub_group_sizes<T, Ops>(queue, host_input, in, out), ...);
+
+  sycl::free(in, queue);
+  sycl::free(out, queue);
+}
+
+TEMPLATE_TEST_CASE("Group algorithm throughput",
+                   "[perf_group_algorithms][benchmark][serial]", int, float,
+                   std::int64_t, sycl::half) {
+  SECTION("joint algorithms") {
+    run_collectives<TestType, collective::joint_reduce,
+                    collective::joint_inclusive_scan,
+                    collective::joint_exclusive_scan>();
+  }
+
+  SECTION("work-group collectives") {
+    run_collectives<TestType, collective::reduce_over_work_group,
+                    collective::inclusive_scan_over_work_group,
+                    collective::exclusive_scan_over_work_group,
+                    collective::broadcast_work_group>();
+  }
+
+  SECTION("sub-group collectives") {
+    run_collectives<TestType, collective::reduce_over_sub_group,
+                    collective::inclusive_scan_over_sub_group,
+                    collective::exclusive_scan_over_sub_group,
+                    collective::broadcast_sub_group,
+                    collective::permute_group_by_xor,
+                    collective::shift_group_left,
+                    collective::shift_group_right>();
+  }
+}
+
+}  // namespace perf_group_algorithms
@@ -0,0 +1,298 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Provides bandwidth benchmarks for the sycl::handler::copy overloads
+//
+*******************************************************************************/
+
+#include "../handler/handler_copy_common.h"
+
+#include "../../util/usm_helper.h"
+#include "../common/benchmark.h"
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace perf_handler_copy {
+using namespace handler_copy_common;
+using namespace sycl_cts;
+
+/** Element type of all copies */
+using element_t = int;
+
+/** Number of copied elements, as powers of two (4 MiB and 64 MiB of data) */
+constexpr unsigned log2Sizes[] = {20, 24};
+
+/**
+ * @brief Returns a buffer extent of 2^log2Elements items that is split as
+ *        evenly as possible over dims dimensions, e.g. 128x128x64 for 2^20
+ *        items in three dimensions.
+ */
+template <int dims>
+sycl::range<3> make_extent(unsigned log2Elements) {
+  sycl::range<3> extent{1, 1, 1};
+  for (int d = 0; d < dims; ++d) {
+    const unsigned remainder = log2Elements % dims;
+    extent[d] = size_t{1} << (log2Elements / dims +
+                              (static_cast<unsigned>(d) < remainder ? 1 : 0));
+  }
+  return extent;
+}
+
+/**
+ * @brief Verifies a single copy, then benchmarks it.
+ *
+ * The verification also moves the buffers to the device, so that their
+ * allocation and initial transfer are not part of the benchmark.
+ */
+template <typename verifyT, typename copyT>
+void run_benchmark(sycl::queue& queue, const std::string& name, size_t bytes,
+                   const verifyT& verify, const copyT& copy) {
+  verify(copy);
+  benchmark::set_work(bytes);
+  BENCHMARK(std::string(name)) {
+    queue.submit([&](sycl::handler& cgh) { copy(cgh); });
+    queue.wait_and_throw();
+  };
+}
+
+template <int dim_src, int dim_dst, bool strided>
+std::string variant_name(const std::string& op, unsigned log2Elements) {
+  return op + " " + std::to_string(dim_src) + "D to " +
+         std::to_string(dim_dst) + "D, " + (strided ? "strided" : "dense") +
+         ", " + benchmark::size_name(sizeof(element_t) << log2Elements);
+}
+
+/**
+ * @brief Benchmarks the device to host overloads, like
+ *        test_read_acc_copy_functions.
+ */
+template <int dim, bool strided>
+void benchmark_read_acc_copy_functions(sycl::queue& queue,
+                                       unsigned log2Elements) {
+  using context_t = copy_test_context<element_t, dim, dim, strided, false>;
+  constexpr auto mode_src = mode_t::read;
+  constexpr auto target = target_t::device;
+  const auto extent = make_extent<dim>(log2Elements);
+  log_helper lh = log_helper{}
+                      .set_data_type<element_t>()
+                      .set_dim_src(dim)
+                      .set_dim_dst(dim)
+                      .set_mode_src(mode_src)
+                      .set_target(target);
+  {
+    context_t ctx(queue, extent);
+    run_benchmark(
+        queue,
+        variant_name<dim, dim, strided>("copy(accessor, shared_ptr)",
+                                        log2Elements),
+        ctx.getSrcCopyRange().size() * sizeof(element_t),
+        [&](const auto& copy) {
+          ctx.verify_d2h_copy(
+              copy, lh.set_line(__LINE__).set_op(
+                        "copy(accessor<$dataT, $dim_src, $mode_src, $target>, "
+                        "shared_ptr_class<$dataT>)"));
+        },
+        [&](sycl::handler& cgh) {
+          auto r = ctx.getSrcBuf().template get_access<mode_src, target>(
+              cgh, ctx.getSrcCopyRange(), ctx.getSrcCopyOffset());
+          cgh.copy(r, ctx.getDstHostPtr());
+        });
+  }
+  {
+    context_t ctx(queue, extent);
+    run_benchmark(
+        queue,
+        variant_name<dim, dim, strided>("copy(accessor, T*)", log2Elements),
+        ctx.getSrcCopyRange().size() * sizeof(element_t),
+        [&](const auto& copy) {
+          ctx.verify_d2h_copy(
+              copy, lh.set_line(__LINE__).set_op(
+                        "copy(accessor<$dataT, $dim_src, $mode_src, $target>, "
+                        "$dataT*)"));
+        },
+        [&](sycl::handler& cgh) {
+          auto r = ctx.getSrcBuf().template get_access<mode_src, target>(
+              cgh, ctx.getSrcCopyRange(), ctx.getSrcCopyOffset());
+          cgh.copy(r, ctx.getDstHostPtr().get());
+        });
+  }
+}
+
+/**
+ * @brief Benchmarks the host to device and device to device overloads, like
+ *        test_write_acc_copy_functions.
+ *
+ * The destination is accessed with discard_write, so that a buffer copy needs
+ * no transfer of the previous destination contents.
+ */
+template <int dim_src, int dim_dst, bool strided>
+void benchmark_write_acc_copy_functions(sycl::queue& queue,
+                                        unsigned log2Elements) {
+  using context_t =
+      copy_test_context<element_t, dim_src, dim_dst, strided, false>;
+  constexpr auto mode_src = mode_t::read;
+  constexpr auto mode_dst = mode_t::discard_write;
+  constexpr auto target = target_t::device;
+  constexpr auto dim_large = dim_src > dim_dst ? dim_src : dim_dst;
+  const auto extent = make_extent<dim_large>(log2Elements);
+  log_helper lh = log_helper{}
+                      .set_data_type<element_t>()
+                      .set_dim_src(dim_src)
+                      .set_dim_dst(dim_dst)
+                      .set_mode_src(mode_src)
+                      .set_mode_dst(mode_dst)
+                      .set_target(target);
+  {
+    context_t ctx(queue, extent);
+    run_benchmark(
+        queue,
+        variant_name<dim_src, dim_dst, strided>("copy(shared_ptr, accessor)",
+                                                log2Elements),
+        ctx.getDstCopyRange().size() * sizeof(element_t),
+        [&](const auto& copy) {
+          ctx.verify_h2d_copy(
+              copy,
+              lh.set_line(__LINE__).set_op(
+                  "copy(shared_ptr_class<$dataT>, accessor<$dataT, $dim_dst, "
+                  "$mode_dst, $target>)"));
+        },
+        [&](sycl::handler& cgh) {
+          auto w = ctx.getDstBuf().template get_access<mode_dst, target>(
+              cgh, ctx.getDstCopyRange(), ctx.getDstCopyOffset());
+          cgh.copy(ctx.getSrcHostPtr(), w);
+        });
+  }
+  {
+    context_t ctx(queue, extent);
+    run_benchmark(
+        queue,
+        variant_name<dim_src, dim_dst, strided>("copy(T*, accessor)",
+                                                log2Elements),
+        ctx.getDstCopyRange().size() * sizeof(element_t),
+        [&](const auto& copy) {
+          ctx.verify_h2d_copy(
+              copy, lh.set_line(__LINE__).set_op(
+                        "copy($dataT*, accessor<$dataT, $dim_dst, $mode_dst, "
+                        "$target>)"));
+        },
+        [&](sycl::handler& cgh) {
+          auto w = ctx.getDstBuf().template get_access<mode_dst, target>(
+              cgh, ctx.getDstCopyRange(), ctx.getDstCopyOffset());
+          cgh.copy(ctx.getSrcHostPtr().get(), w);
+        });
+  }
+  {
+    context_t ctx(queue, extent);
+    run_benchmark(
+        queue,
+        variant_name<dim_src, dim_dst, strided>("copy(accessor, accessor)",
+                                                log2Elements),
+        ctx.getDstCopyRange().size() * sizeof(element_t),
+        [&](const auto& copy) {
+          ctx.verify_d2d_copy(
+              copy, lh.set_line(__LINE__).set_op(
+                        "copy(accessor<$dataT, $dim_src, $mode_src, $target>, "
+                        "accessor<$dataT, $dim_dst, $mode_dst, $target>)"));
+        },
+        [&](sycl::handler& cgh) {
+          auto r = ctx.getSrcBuf().template get_access<mode_src, target>(
+              cgh, ctx.getSrcCopyRange(), ctx.getSrcCopyOffset());
+          auto w = ctx.getDstBuf().template get_access<mode_dst, target>(
+              cgh, ctx.getDstCopyRange(), ctx.getDstCopyOffset());
+          cgh.copy(r, w);
+        });
+  }
+}
+
+/**
+ * @brief Benchmarks all combinations of source and destination dimensions,
+ *        like test_all_dimensions.
+ */
+template <bool strided>
+void benchmark_all_dimensions(sycl::queue& queue, unsigned log2Elements) {
+  benchmark_read_acc_copy_functions<1, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<1, 1, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<1, 2, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<1, 3, strided>(queue, log2Elements);
+
+  benchmark_read_acc_copy_functions<2, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<2, 1, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<2, 2, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<2, 3, strided>(queue, log2Elements);
+
+  benchmark_read_acc_copy_functions<3, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<3, 1, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<3, 2, strided>(queue, log2Elements);
+  benchmark_write_acc_copy_functions<3, 3, strided>(queue, log2Elements);
+}
+
+/**
+ * @brief Benchmarks the USM memcpy that is equivalent to a dense handler::copy
+ *        of the same size, using ordinary host memory like the copies do.
+ */
+void benchmark_usm_memcpy(sycl::queue& queue, unsigned log2Elements) {
+  constexpr auto kind = sycl::usm::alloc::device;
+  if (!queue.get_device().has(usm_helper::get_aspect<kind>())) {
+    WARN("Device does not support device USM allocations, skipping the USM "
+         "memcpy baseline");
+    return;
+  }
+  const size_t count = size_t{1} << log2Elements;
+  const size_t bytes = count * sizeof(element_t);
+  const auto size = benchmark::size_name(bytes);
+
+  auto host = std::make_unique<element_t[]>(count);
+  auto device = usm_helper::allocate_usm_memory<kind, element_t>(queue, count);
+  auto otherDevice =
+      usm_helper::allocate_usm_memory<kind, element_t>(queue, count);
+  std::fill_n(host.get(), count, element_t{1});
+  queue.memset(device.get(), 0, bytes);
+  queue.memset(otherDevice.get(), 0, bytes);
+  queue.wait_and_throw();
+
+  const auto run = [&](const std::string& name, const element_t* src,
+                       element_t* dst) {
+    benchmark::set_work(bytes);
+    BENCHMARK(name + ", " + size) {
+      queue.memcpy(dst, src, bytes);
+      queue.wait_and_throw();
+    };
+  };
+  run("USM memcpy device to host", device.get(), host.get());
+  run("USM memcpy host to device", host.get(), device.get());
+  run("USM memcpy device to device", device.get(), otherDevice.get());
+}
+
+/**
+ * @brief Checks whether the buffers of 2^log2Elements items fit into device
+ *        memory
+ */
+bool fits(const sycl::queue& queue, unsigned log2Elements) {
+  const auto device = queue.get_device();
+  const size_t bytes = sizeof(element_t) << log2Elements;
+  return bytes <= device.get_info<sycl::info::device::max_mem_alloc_size>() &&
+         2 * bytes <= device.get_info<sycl::info::device::global_mem_size>();
+}
+
+TEST_CASE("Bandwidth of sycl::handler::copy",
+          "[perf_handler_copy][benchmark][serial]") {
+  auto queue = util::get_cts_object::queue();
+
+  for (const auto log2Elements : log2Sizes) {
+    if (!fits(queue, log2Elements)) {
+      WARN("Skipping copies of " +
+           benchmark::size_name(sizeof(element_t) << log2Elements) +
+           ", which do not fit into device memory");
+      continue;
+    }
+    benchmark_usm_memcpy(queue, log2Elements);
+    benchmark_all_dimensions<false>(queue, log2Elements);
+    benchmark_all_dimensions<true>(queue, log2Elements);
+  }
+}
+
+}  // namespace perf_handler_copy
@@ -0,0 +1,182 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides benchmarks for kernel launch latency and submission throughput.
+//
+*******************************************************************************/
+
+#include "../common/benchmark.h"
+
+namespace perf_launch {
+using namespace sycl_cts;
+
+enum class launch_kind { single_task, range, nd_range };
+
+template <launch_kind kind, size_t payloadSize>
+class launch_kernel;
+
+/** Number of kernels submitted per run of a throughput benchmark */
+constexpr size_t submissions_per_run = 256;
+
+/**
+ * @brief Data captured by value in the kernel lambda, like the structs of the
+ *        kernel_args category, to measure the cost of larger kernel arguments
+ */
+template <size_t size>
+struct payload {
+  unsigned char data[size];
+};
+
+inline std::string kind_name(launch_kind kind) {
+  switch (kind) {
+    case launch_kind::single_task:
+      return "single_task";
+    case launch_kind::range:
+      return "parallel_for(range)";
+    case launch_kind::nd_range:
+      return "parallel_for(nd_range)";
+  }
+  return {};
+}
+
+inline std::string kernel_name(launch_kind kind, size_t payloadSize) {
+  return kind_name(kind) + ", " + benchmark::size_name(payloadSize) +
+         " captured";
+}
+
+template <launch_kind kind, typename kernelName, typename functorT>
+void launch(sycl::handler& cgh, const functorT& f) {
+  if constexpr (kind == launch_kind::single_task) {
+    cgh.single_task<kernelName>(f);
+  } else if constexpr (kind == launch_kind::range) {
+    cgh.parallel_for<kernelName>(sycl::range<1>(1),
+                                 [=](sycl::id<1>) { f(); });
+  } else {
+    cgh.parallel_for<kernelName>(
+        sycl::nd_range<1>(sycl::range<1>(1), sycl::range<1>(1)),
+        [=](sycl::nd_item<1>) { f(); });
+  }
+}
+
+/**
+ * @brief Submits a kernel that does no work apart from reading its payload
+ * @param sink Device memory the kernel would write to if the payload was not
+ *        all zeros, which keeps the payload from being optimized away
+ */
+template <launch_kind kind, size_t payloadSize>
+sycl::event submit(sycl::queue& queue, int* sink) {
+  using kernel_name_t = launch_kernel<kind, payloadSize>;
+  if constexpr (payloadSize == 0) {
+    return queue.submit(
+        [&](sycl::handler& cgh) { launch<kind, kernel_name_t>(cgh, [] {}); });
+  } else {
+    const payload<payloadSize> p{};
+    return queue.submit([&](sycl::handler& cgh) {
+      launch<kind, kernel_name_t>(cgh, [=] {
+        if (p.data[payloadSize - 1] != 0) *sink = p.data[0];
+      });
+    });
+  }
+}
+
+template <launch_kind kind, size_t payloadSize>
+void benchmark_latency(sycl::queue& queue, int* sink) {
+  BENCHMARK(kernel_name(kind, payloadSize)) {
+    submit<kind, payloadSize>(queue, sink).wait();
+  };
+}
+
+template <launch_kind kind, size_t payloadSize>
+void benchmark_throughput(sycl::queue& queue, int* sink) {
+  benchmark::set_work(0, submissions_per_run);
+  BENCHMARK(kernel_name(kind, payloadSize) + ", " +
+            std::to_string(submissions_per_run) + " submissions") {
+    for (size_t i = 0; i < submissions_per_run; ++i)
+      submit<kind, payloadSize>(queue, sink);
+    queue.wait();
+  };
+}
+
+/**
+ * @brief Runs a benchmark for every launch kind and payload size; the
+ *        payload is limited to 512 bytes to stay below the minimum kernel
+ *        parameter size devices have to support
+ */
+template <template <launch_kind, size_t> class benchmarkT>
+void for_all_launches(sycl::queue& queue, int* sink) {
+  benchmarkT<launch_kind::single_task, 0>{}(queue, sink);
+  benchmarkT<launch_kind::range, 0>{}(queue, sink);
+  benchmarkT<launch_kind::nd_range, 0>{}(queue, sink);
+  if (sink == nullptr) {
+    WARN("Device does not support USM device allocations, skipping kernels "
+         "with captured payloads");
+    return;
+  }
+  benchmarkT<launch_kind::single_task, 64>{}(queue, sink);
+  benchmarkT<launch_kind::range, 64>{}(queue, sink);
+  benchmarkT<launch_kind::nd_range, 64>{}(queue, sink);
+  benchmarkT<launch_kind::single_task, 512>{}(queue, sink);
+  benchmarkT<launch_kind::range, 512>{}(queue, sink);
+  benchmarkT<launch_kind::nd_range, 512>{}(queue, sink);
+}
+
+template <launch_kind kind, size_t payloadSize>
+struct latency {
+  void operator()(sycl::queue& queue, int* sink) const {
+    benchmark_latency<kind, payloadSize>(queue, sink);
+  }
+};
+
+template <launch_kind kind, size_t payloadSize>
+struct throughput {
+  void operator()(sycl::queue& queue, int* sink) const {
+    benchmark_throughput<kind, payloadSize>(queue, sink);
+  }
+};
+
+int* allocate_sink(sycl::queue& queue) {
+  if (!queue.get_device().has(sycl::aspect::usm_device_allocations))
+    return nullptr;
+  return sycl::malloc_device<int>(1, queue);
+}
+
+TEST_CASE("Kernel submit-to-completion latency",
+          "[perf_launch][benchmark][serial]") {
+  auto queue = util::get_cts_object::queue();
+  int* sink = allocate_sink(queue);
+  for_all_launches<latency>(queue, sink);
+  if (sink != nullptr) sycl::free(sink, queue);
+}
+
+TEST_CASE("Kernel submission throughput", "[perf_launch][benchmark][serial]") {
+  SECTION("out-of-order queue") {
+    auto queue = util::get_cts_object::queue();
+    int* sink = allocate_sink(queue);
+    for_all_launches<throughput>(queue, sink);
+    if (sink != nullptr) sycl::free(sink, queue);
+  }
+
+  SECTION("in-order queue") {
+    auto& queue = util::get<util::sycl_object_cache>().in_order_queue();
+    int* sink = allocate_sink(queue);
+    for_all_launches<throughput>(queue, sink);
+    if (sink != nullptr) sycl::free(sink, queue);
+  }
+}
+
+}  // namespace perf_launch
@@ -0,0 +1,236 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides throughput benchmarks for async_work_group_copy and the staging of
+//  data through local memory
+//
+*******************************************************************************/
+
+#include "../common/benchmark.h"
+
+#include <catch2/catch_template_test_macros.hpp>
+
+#include <iterator>
+#include <vector>
+
+namespace perf_local_memory {
+using namespace sycl_cts;
+
+/** Work-group sizes to measure, larger ones are skipped if unsupported */
+constexpr size_t work_group_sizes[] = {64, 256, 1024};
+
+/** Strides of the global memory accesses, in elements */
+constexpr size_t strides[] = {1, 4};
+
+/** Total number of copied elements of one kernel */
+constexpr size_t length = size_t{1} << 20;
+
+/** Number of elements of the local memory tile per work-item */
+constexpr size_t elements_per_work_item = 4;
+
+enum class copy_method {
+  async_work_group_copy,  // async_work_group_copy followed by wait_for
+  cooperative_loop,       // every work-item copies a part, then a barrier
+  global_only             // no local memory, global memory is used directly
+};
+
+enum class copy_direction { global_to_local, local_to_global };
+
+inline std::string method_name(copy_method method) {
+  switch (method) {
+    case copy_method::async_work_group_copy:
+      return "async_work_group_copy";
+    case copy_method::cooperative_loop:
+      return "cooperative copy loop";
+    case copy_method::global_only:
+      return "global memory only";
+  }
+  return {};
+}
+
+inline std::string direction_name(copy_direction direction) {
+  switch (direction) {
+    case copy_direction::global_to_local:
+      return "global to local";
+    case copy_direction::local_to_global:
+      return "local to global";
+  }
+  return {};
+}
+
+template <typename T, copy_method Method, copy_direction Direction>
+class local_memory_kernel;
+
+/**
+ * @brief Value that is written to the element with the given index
+ */
+template <typename T>
+T make_value(size_t index) {
+  return static_cast<T>(static_cast<int>(index & 0xff));
+}
+
+/**
+ * @brief Submits a kernel that moves one tile of elements_per_work_item
+ *        elements per work-item between global and local memory in every
+ *        work-group.
+ *
+ * Global to local kernels then sum up the elements of each work-item from
+ * local memory and write one result per work-item, so that the copy cannot be
+ * optimized away. Local to global kernels fill the tile in local memory before
+ * copying it. The global_only method does the same global memory accesses
+ * without staging them through local memory.
+ */
+template <typename T, copy_method Method, copy_direction Direction>
+sycl::event submit(sycl::queue& queue, sycl::buffer<T, 1>& global,
+                   sycl::buffer<T, 1>& results, size_t workGroupSize,
+                   size_t stride) {
+  return queue.submit([&](sycl::handler& cgh) {
+    using kernel_name = local_memory_kernel<T, Method, Direction>;
+    constexpr bool usesLocal = Method != copy_method::global_only;
+    const size_t tile = workGroupSize * elements_per_work_item;
+
+    auto accGlobal =
+        global.template get_access<sycl::access_mode::read_write>(cgh);
+    auto accResults =
+        results.template get_access<sycl::access_mode::discard_write>(cgh);
+    auto accLocal =
+        sycl::accessor<T, 1, sycl::access_mode::read_write,
+                       sycl::target::local>(
+            sycl::range<1>(usesLocal ? tile : 1), cgh);
+
+    const sycl::nd_range<1> range{
+        sycl::range<1>{length / elements_per_work_item},
+        sycl::range<1>{workGroupSize}};
+    cgh.parallel_for<kernel_name>(range, [=](sycl::nd_item<1> item) {
+      using difference_type = typename sycl::global_ptr<T>::difference_type;
+      const size_t lid = item.get_local_linear_id();
+      const auto offset =
+          static_cast<difference_type>(item.get_group_linear_id() * tile *
+                                       stride);
+      auto ptrGlobal = accGlobal.get_pointer() + offset;
+      auto ptrLocal = accLocal.get_pointer();
+
+      if constexpr (Direction == copy_direction::global_to_local) {
+        T sum = make_value<T>(0);
+        if constexpr (Method == copy_method::global_only) {
+          for (size_t i = lid; i < tile; i += workGroupSize)
+            sum += ptrGlobal[i * stride];
+        } else {
+          if constexpr (Method == copy_method::async_work_group_copy) {
+            auto event =
+                item.async_work_group_copy(ptrLocal, ptrGlobal, tile, stride);
+            item.wait_for(event);
+          } else {
+            for (size_t i = lid; i < tile; i += workGroupSize)
+              ptrLocal[i] = ptrGlobal[i * stride];
+            item.barrier(sycl::access::fence_space::local_space);
+          }
+          for (size_t i = lid; i < tile; i += workGroupSize)
+            sum += ptrLocal[i];
+        }
+        accResults[item.get_global_linear_id()] = sum;
+      } else {
+        if constexpr (Method == copy_method::global_only) {
+          for (size_t i = lid; i < tile; i += workGroupSize)
+            ptrGlobal[i * stride] = make_value<T>(i);
+        } else {
+          for (size_t i = lid; i < tile; i += workGroupSize)
+            ptrLocal[i] = make_value<T>(i);
+          item.barrier(sycl::access::fence_space::local_space);
+          if constexpr (Method == copy_method::async_work_group_copy) {
+            auto event =
+                item.async_work_group_copy(ptrGlobal, ptrLocal, tile, stride);
+            item.wait_for(event);
+          } else {
+            for (size_t i = lid; i < tile; i += workGroupSize)
+              ptrGlobal[i * stride] = ptrLocal[i];
+          }
+        }
+      }
+    });
+  });
+}
+
+template <typename T, copy_method Method, copy_direction Direction>
+void benchmark_copy(sycl::queue& queue, sycl::buffer<T, 1>& global,
+                    sycl::buffer<T, 1>& results) {
+  const auto device = queue.get_device();
+  const size_t maxWorkGroupSize =
+      device.get_info<sycl::info::device::max_work_group_size>();
+  const size_t localMemSize =
+      device.get_info<sycl::info::device::local_mem_size>();
+
+  for (size_t workGroupSize : work_group_sizes) {
+    if (workGroupSize > maxWorkGroupSize) break;
+    if (workGroupSize * elements_per_work_item * sizeof(T) > localMemSize)
+      break;
+    for (size_t stride : strides) {
+      benchmark::set_work(length * sizeof(T), length);
+      BENCHMARK(method_name(Method) + ", " + direction_name(Direction) +
+                ", work-group size " + std::to_string(workGroupSize) +
+                ", stride " + std::to_string(stride)) {
+        submit<T, Method, Direction>(queue, global, results, workGroupSize,
+                                     stride)
+            .wait_and_throw();
+      };
+    }
+  }
+}
+
+/**
+ * @brief Benchmarks all copy methods in the given direction
+ */
+template <typename T, copy_direction Direction>
+void benchmark_all_methods(sycl::queue& queue, sycl::buffer<T, 1>& global,
+                           sycl::buffer<T, 1>& results) {
+  benchmark_copy<T, copy_method::async_work_group_copy, Direction>(
+      queue, global, results);
+  benchmark_copy<T, copy_method::cooperative_loop, Direction>(queue, global,
+                                                              results);
+  benchmark_copy<T, copy_method::global_only, Direction>(queue, global,
+                                                         results);
+}
+
+TEMPLATE_TEST_CASE("Local memory staging throughput",
+                   "[perf_local_memory][benchmark][serial]", int, float,
+                   sycl::int2, sycl::float4) {
+  auto queue = util::get_cts_object::queue();
+
+  constexpr size_t maxStride = strides[std::size(strides) - 1];
+  std::vector<TestType> hostData(length * maxStride);
+  for (size_t i = 0; i < hostData.size(); ++i)
+    hostData[i] = make_value<TestType>(i);
+
+  sycl::buffer<TestType, 1> global(hostData.data(),
+                                   sycl::range<1>(hostData.size()));
+  global.set_final_data(nullptr);
+  sycl::buffer<TestType, 1> results(
+      sycl::range<1>(length / elements_per_work_item));
+
+  SECTION("global to local") {
+    benchmark_all_methods<TestType, copy_direction::global_to_local>(
+        queue, global, results);
+  }
+
+  SECTION("local to global") {
+    benchmark_all_methods<TestType, copy_direction::local_to_global>(
+        queue, global, results);
+  }
+}
+
+}  // namespace perf_local_memory
@@ -0,0 +1,297 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides benchmarks for the overhead of sycl::stream in kernels
+//
+*******************************************************************************/
+
+#include "../common/benchmark.h"
+
+#include <catch2/interfaces/catch_interfaces_config.hpp>
+#include <catch2/internal/catch_context.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace perf_stream {
+using namespace sycl_cts;
+
+/** Number of work-items of every kernel */
+constexpr size_t global_size = 4096;
+
+/** Total buffer sizes of the streams, in bytes */
+constexpr size_t buffer_sizes[] = {4 * 1024, 256 * 1024, 4 * 1024 * 1024};
+
+/** Maximum statement sizes of the streams, in bytes */
+constexpr size_t statement_sizes[] = {80, 1024};
+
+/** Numbers of work-items that write output */
+constexpr size_t writer_counts[] = {1, 256, global_size};
+
+/** Output written by each writing work-item, in bytes */
+constexpr size_t bytes_per_writer[] = {16, 256};
+
+/** Length of each line of output, including the line break */
+constexpr size_t line_length = 16;
+
+enum class output_kind { none, stream, global_memory };
+
+template <output_kind kind>
+class stream_kernel;
+
+/**
+ * @brief Redirects stdout to the null device while it exists, so that the
+ *        stream output neither floods the log nor depends on the terminal
+ */
+class stdout_discarder {
+ public:
+  stdout_discarder() {
+    std::cout.flush();
+    std::fflush(stdout);
+#ifdef _WIN32
+    m_saved = _dup(_fileno(stdout));
+    const int nullDevice = _open("NUL", _O_WRONLY);
+    if (m_saved != -1 && nullDevice != -1) _dup2(nullDevice, _fileno(stdout));
+    if (nullDevice != -1) _close(nullDevice);
+#else
+    m_saved = dup(fileno(stdout));
+    const int nullDevice = open("/dev/null", O_WRONLY);
+    if (m_saved != -1 && nullDevice != -1) dup2(nullDevice, fileno(stdout));
+    if (nullDevice != -1) close(nullDevice);
+#endif
+  }
+
+  ~stdout_discarder() {
+    std::cout.flush();
+    std::fflush(stdout);
+    if (m_saved == -1) return;
+#ifdef _WIN32
+    _dup2(m_saved, _fileno(stdout));
+    _close(m_saved);
+#else
+    dup2(m_saved, fileno(stdout));
+    close(m_saved);
+#endif
+  }
+
+  stdout_discarder(const stdout_discarder&) = delete;
+  stdout_discarder& operator=(const stdout_discarder&) = delete;
+
+ private:
+  int m_saved = -1;
+};
+
+/**
+ * @brief Configuration of a kernel: which output it writes, through a stream
+ *        of which size, and how much of it
+ */
+struct kernel_config {
+  output_kind kind = output_kind::none;
+  size_t bufferSize = 0;
+  size_t statementSize = 0;
+  size_t writers = 0;
+  size_t bytesPerWriter = 0;
+
+  size_t output_bytes() const { return writers * bytesPerWriter; }
+
+  std::string name() const {
+    const std::string output =
+        writers == 0 ? "unused"
+                     : std::to_string(writers) + " work-items writing " +
+                           benchmark::size_name(bytesPerWriter) + " each";
+    switch (kind) {
+      case output_kind::none:
+        return "no stream";
+      case output_kind::stream:
+        return "stream, " + benchmark::size_name(bufferSize) + " buffer, " +
+               benchmark::size_name(statementSize) + " statements, " + output;
+      case output_kind::global_memory:
+        return "global memory, " + output;
+    }
+    return {};
+  }
+};
+
+/**
+ * @brief Submits a kernel in which every work-item writes its id to results,
+ *        and the first config.writers work-items write config.bytesPerWriter
+ *        bytes of output in lines of line_length bytes.
+ *
+ * The stream is constructed for every kernel, even if no work-item writes to
+ * it, so that its fixed cost is part of the measurement. The global_memory
+ * kind writes the same bytes to global memory instead, which separates the
+ * cost of formatting and flushing the stream from the cost of the writes.
+ */
+template <output_kind kind>
+sycl::event submit(sycl::queue& queue, const kernel_config& config,
+                   sycl::buffer<int, 1>& results,
+                   sycl::buffer<char, 1>& output) {
+  return queue.submit([&](sycl::handler& cgh) {
+    auto accResults =
+        results.get_access<sycl::access_mode::discard_write>(cgh);
+    const size_t writers = config.writers;
+    const size_t lines = config.bytesPerWriter / line_length;
+    const sycl::range<1> range{global_size};
+
+    if constexpr (kind == output_kind::none) {
+      cgh.parallel_for<stream_kernel<kind>>(range, [=](sycl::item<1> item) {
+        accResults[item] = static_cast<int>(item.get_linear_id());
+      });
+    } else if constexpr (kind == output_kind::stream) {
+      sycl::stream os(config.bufferSize, config.statementSize, cgh);
+      cgh.parallel_for<stream_kernel<kind>>(range, [=](sycl::item<1> item) {
+        const size_t id = item.get_linear_id();
+        if (id < writers) {
+          for (size_t line = 0; line < lines; ++line)
+            os << "sycl::stream..." << sycl::endl;
+        }
+        accResults[item] = static_cast<int>(id);
+      });
+    } else {
+      auto accOutput = output.get_access<sycl::access_mode::write>(cgh);
+      cgh.parallel_for<stream_kernel<kind>>(range, [=](sycl::item<1> item) {
+        const size_t id = item.get_linear_id();
+        if (id < writers) {
+          const char text[] = "sycl::stream...\n";
+          const size_t offset = id * lines * line_length;
+          for (size_t i = 0; i < lines * line_length; ++i)
+            accOutput[offset + i] = text[i % line_length];
+        }
+        accResults[item] = static_cast<int>(id);
+      });
+    }
+  });
+}
+
+/**
+ * @brief Benchmarks the submit-to-completion time of the kernel.
+ *
+ * With a profiling queue, every run also measures the host time after the
+ * command ended: the time from submission until the wait returns, minus the
+ * time from command_submit to command_end of the kernel. The stream is flushed
+ * in this time, so it is stored as the flush latency of the configuration,
+ * next to that of the kernels without a stream. Only the runs of the last
+ * `benchmarkSamples()` calls of the benchmark body are kept: Catch2 calls it
+ * before those to warm up and to estimate the iterations per sample.
+ */
+template <output_kind kind>
+void run_benchmark(sycl::queue& queue, const kernel_config& config,
+                   sycl::buffer<int, 1>& results,
+                   sycl::buffer<char, 1>& output) {
+  using namespace sycl::info;
+  const bool profiling =
+      queue.has_property<sycl::property::queue::enable_profiling>();
+  // Flush latencies of each call of the benchmark body
+  std::vector<std::vector<double>> callFlushNs;
+
+  benchmark::set_work(config.output_bytes(), global_size);
+  BENCHMARK_ADVANCED(config.name())(Catch::Benchmark::Chronometer meter) {
+    const stdout_discarder discard;
+    auto& flushNs = callFlushNs.emplace_back();
+    meter.measure([&] {
+      const auto start = std::chrono::steady_clock::now();
+      auto event = submit<kind>(queue, config, results, output);
+      event.wait_and_throw();
+      const std::chrono::duration<double, std::nano> hostNs =
+          std::chrono::steady_clock::now() - start;
+      if (profiling) {
+        const auto submitted =
+            event.get_profiling_info<event_profiling::command_submit>();
+        const auto ended =
+            event.get_profiling_info<event_profiling::command_end>();
+        flushNs.push_back(hostNs.count() -
+                          static_cast<double>(ended - submitted));
+      }
+    });
+  };
+
+  const size_t samples =
+      Catch::getCurrentContext().getConfig()->benchmarkSamples();
+  const auto firstSample =
+      callFlushNs.size() > samples ? callFlushNs.size() - samples : 0;
+  std::vector<double> flushNs;
+  for (size_t i = firstSample; i < callFlushNs.size(); ++i) {
+    flushNs.insert(flushNs.end(), callFlushNs[i].begin(),
+                   callFlushNs[i].end());
+  }
+  benchmark::add_derived(config.name() + ", flush latency", flushNs);
+}
+
+TEST_CASE("sycl::stream overhead", "[perf_stream][benchmark][serial]") {
+  const auto device = util::get_cts_object::device();
+  sycl::queue queue = util::get_cts_object::queue();
+  if (device.has(sycl::aspect::queue_profiling)) {
+    queue = sycl::queue(util::get<util::sycl_object_cache>().context(), device,
+                        cts_async_handler{},
+                        sycl::property::queue::enable_profiling{});
+  } else {
+    WARN("Device does not support queue profiling, the flush latency is not "
+         "measured");
+  }
+
+  sycl::buffer<int, 1> results{sycl::range<1>{global_size}};
+  constexpr size_t maxBytesPerWriter =
+      bytes_per_writer[std::size(bytes_per_writer) - 1];
+  sycl::buffer<char, 1> output{sycl::range<1>{global_size * maxBytesPerWriter}};
+
+  SECTION("fixed overhead") {
+    run_benchmark<output_kind::none>(queue, kernel_config{}, results, output);
+    for (size_t bufferSize : buffer_sizes) {
+      for (size_t statementSize : statement_sizes) {
+        const kernel_config config{output_kind::stream, bufferSize,
+                                   statementSize, 0, 0};
+        run_benchmark<output_kind::stream>(queue, config, results, output);
+      }
+    }
+  }
+
+  SECTION("output") {
+    for (size_t writers : writer_counts) {
+      for (size_t bytes : bytes_per_writer) {
+        const kernel_config baseline{output_kind::global_memory, 0, 0, writers,
+                                     bytes};
+        run_benchmark<output_kind::global_memory>(queue, baseline, results,
+                                                  output);
+        for (size_t bufferSize : buffer_sizes) {
+          // Output that does not fit into the buffer is dropped, which would
+          // overstate the throughput
+          if (writers * bytes > bufferSize) continue;
+          for (size_t statementSize : statement_sizes) {
+            const kernel_config config{output_kind::stream, bufferSize,
+                                       statementSize, writers, bytes};
+            run_benchmark<output_kind::stream>(queue, config, results,
+                                               output);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace perf_stream
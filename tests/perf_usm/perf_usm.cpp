@@ -0,0 +1,294 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides USM transfer bandwidth benchmarks for every allocation kind
+//
+*******************************************************************************/
+
+#include "../common/benchmark.h"
+#include "../usm/usm_api.h"
+
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace perf_usm {
+using namespace sycl_cts;
+using namespace usm_api;
+
+/** Sizes of the transfers, in bytes */
+constexpr size_t sizes[] = {64,
+                            1024,
+                            16 * 1024,
+                            256 * 1024,
+                            4 * 1024 * 1024,
+                            64 * 1024 * 1024,
+                            size_t{1024} * 1024 * 1024,
+                            size_t{4} * 1024 * 1024 * 1024};
+
+/** Element type of all allocations, fill() uses it as its pattern */
+using element_t = int;
+
+template <allocation alloc>
+using allocation_t = std::integral_constant<allocation, alloc>;
+
+/**
+ * @brief Calls action for every allocation type
+ */
+template <typename actionT>
+void for_each_allocation(const actionT& action) {
+  action(allocation_t<allocation::non_usm>{});
+  action(allocation_t<allocation::host>{});
+  action(allocation_t<allocation::device>{});
+  action(allocation_t<allocation::shared>{});
+}
+
+/**
+ * @brief Calls action for every USM allocation type
+ */
+template <typename actionT>
+void for_each_usm_allocation(const actionT& action) {
+  action(allocation_t<allocation::host>{});
+  action(allocation_t<allocation::device>{});
+  action(allocation_t<allocation::shared>{});
+}
+
+template <allocation alloc>
+bool is_supported(const sycl::queue& queue) {
+  if constexpr (alloc == allocation::non_usm) {
+    return true;
+  } else {
+    constexpr auto kind = map_usm_allocation<alloc>();
+    return queue.get_device().has(usm_helper::get_aspect<kind>());
+  }
+}
+
+/**
+ * @brief Checks whether the given number of allocations of the given size fit
+ *        into device memory
+ */
+bool fits(const sycl::queue& queue, size_t size, size_t allocations) {
+  const auto device = queue.get_device();
+  return size <= device.get_info<sycl::info::device::max_mem_alloc_size>() &&
+         size * allocations <=
+             device.get_info<sycl::info::device::global_mem_size>();
+}
+
+/**
+ * @brief Allocates storage for size bytes and touches all of its pages, so
+ *        that first-touch costs are not part of the benchmark
+ * @return Storage holding nullptr if the allocation failed, which is reported
+ *         as a warning
+ */
+template <allocation alloc>
+auto allocate_bytes(sycl::queue& queue, size_t size) {
+  const size_t count = size / sizeof(element_t);
+  const auto warn_failure = [&] {
+    WARN("Skipping " + get_allocation_decription<alloc>() + " transfers of " +
+         benchmark::size_name(size) + ", the allocation failed");
+  };
+  if constexpr (alloc == allocation::non_usm) {
+    // Host memory is not limited by the device, and std::make_unique throws
+    // instead of returning nullptr when it runs out
+    std::unique_ptr<element_t[]> storage;
+    try {
+      storage = allocate<element_t, alloc>(queue, count);
+    } catch (const std::bad_alloc&) {
+      warn_failure();
+    }
+    return storage;
+  } else {
+    auto storage = allocate<element_t, alloc>(queue, count);
+    if (storage) {
+      queue.memset(storage.get(), 0, size).wait_and_throw();
+    } else {
+      warn_failure();
+    }
+    return storage;
+  }
+}
+
+template <typename callerT>
+std::string caller_name() {
+  if constexpr (std::is_same_v<callerT, caller::queue>) {
+    return "queue shortcut";
+  } else {
+    return "handler";
+  }
+}
+
+/**
+ * @brief Benchmarks an operation with the given caller, waiting for its
+ *        completion each time
+ */
+template <typename callerT, typename actionT>
+void run_benchmark(sycl::queue& queue, const std::string& name, size_t size,
+                   const actionT& action) {
+  benchmark::set_work(size);
+  BENCHMARK(caller_name<callerT>() + ", " + name) {
+    callerT::submit(queue, action);
+    queue.wait_and_throw();
+  };
+}
+
+template <typename callerT>
+void benchmark_memcpy(sycl::queue& queue, size_t size) {
+  for_each_allocation([&](auto source) {
+    for_each_allocation([&](auto destination) {
+      constexpr allocation src = decltype(source)::value;
+      constexpr allocation dst = decltype(destination)::value;
+      if (!is_supported<src>(queue) || !is_supported<dst>(queue)) return;
+
+      auto srcStorage = allocate_bytes<src>(queue, size);
+      auto dstStorage = allocate_bytes<dst>(queue, size);
+      if (!srcStorage || !dstStorage) return;
+      const element_t* srcPtr = srcStorage.get();
+      element_t* dstPtr = dstStorage.get();
+
+      run_benchmark<callerT>(
+          queue,
+          "from " + get_allocation_decription<src>() + " to " +
+              get_allocation_decription<dst>() + ", " +
+              benchmark::size_name(size),
+          size, [&](typename callerT::type& parent) {
+            parent.memcpy(dstPtr, srcPtr, size);
+          });
+    });
+  });
+}
+
+template <typename callerT>
+void benchmark_memset(sycl::queue& queue, size_t size) {
+  for_each_usm_allocation([&](auto allocationType) {
+    constexpr allocation alloc = decltype(allocationType)::value;
+    if (!is_supported<alloc>(queue)) return;
+
+    auto storage = allocate_bytes<alloc>(queue, size);
+    if (!storage) return;
+    element_t* ptr = storage.get();
+
+    run_benchmark<callerT>(
+        queue,
+        get_allocation_decription<alloc>() + ", " + benchmark::size_name(size),
+        size,
+        [&](typename callerT::type& parent) { parent.memset(ptr, 1, size); });
+  });
+}
+
+template <typename callerT>
+void benchmark_fill(sycl::queue& queue, size_t size) {
+  for_each_usm_allocation([&](auto allocationType) {
+    constexpr allocation alloc = decltype(allocationType)::value;
+    if (!is_supported<alloc>(queue)) return;
+
+    auto storage = allocate_bytes<alloc>(queue, size);
+    if (!storage) return;
+    element_t* ptr = storage.get();
+    const size_t count = size / sizeof(element_t);
+
+    run_benchmark<callerT>(
+        queue,
+        get_allocation_decription<alloc>() + ", " + benchmark::size_name(size),
+        size, [&](typename callerT::type& parent) {
+          parent.fill(ptr, element_t{1}, count);
+        });
+  });
+}
+
+template <typename callerT>
+void benchmark_prefetch(sycl::queue& queue, size_t size) {
+  for_each_usm_allocation([&](auto allocationType) {
+    constexpr allocation alloc = decltype(allocationType)::value;
+    if (!is_supported<alloc>(queue)) return;
+
+    auto storage = allocate_bytes<alloc>(queue, size);
+    if (!storage) return;
+    element_t* ptr = storage.get();
+
+    run_benchmark<callerT>(
+        queue,
+        get_allocation_decription<alloc>() + ", " + benchmark::size_name(size),
+        size,
+        [&](typename callerT::type& parent) { parent.prefetch(ptr, size); });
+  });
+}
+
+/**
+ * @brief Runs a benchmark for every size that fits into device memory and for
+ *        both the queue shortcuts and handler submission
+ * @param allocations Number of allocations of each size the benchmark needs
+ */
+template <template <typename> class benchmarkT>
+void for_all_sizes(size_t allocations) {
+  auto queue = util::get_cts_object::queue();
+  for (size_t size : sizes) {
+    if (!fits(queue, size, allocations)) {
+      WARN("Skipping " + benchmark::size_name(size) +
+           " transfers, they do not fit into device memory");
+      break;
+    }
+    benchmarkT<caller::queue>{}(queue, size);
+    benchmarkT<caller::handler>{}(queue, size);
+  }
+}
+
+template <typename callerT>
+struct memcpy_benchmark {
+  void operator()(sycl::queue& queue, size_t size) const {
+    benchmark_memcpy<callerT>(queue, size);
+  }
+};
+
+template <typename callerT>
+struct memset_benchmark {
+  void operator()(sycl::queue& queue, size_t size) const {
+    benchmark_memset<callerT>(queue, size);
+  }
+};
+
+template <typename callerT>
+struct fill_benchmark {
+  void operator()(sycl::queue& queue, size_t size) const {
+    benchmark_fill<callerT>(queue, size);
+  }
+};
+
+template <typename callerT>
+struct prefetch_benchmark {
+  void operator()(sycl::queue& queue, size_t size) const {
+    benchmark_prefetch<callerT>(queue, size);
+  }
+};
+
+TEST_CASE("USM memcpy bandwidth", "[perf_usm][benchmark][serial]") {
+  for_all_sizes<memcpy_benchmark>(2);
+}
+
+TEST_CASE("USM memset bandwidth", "[perf_usm][benchmark][serial]") {
+  for_all_sizes<memset_benchmark>(1);
+}
+
+TEST_CASE("USM fill bandwidth", "[perf_usm][benchmark][serial]") {
+  for_all_sizes<fill_benchmark>(1);
+}
+
+TEST_CASE("USM prefetch bandwidth", "[perf_usm][benchmark][serial]") {
+  for_all_sizes<prefetch_benchmark>(1);
+}
+
+}  // namespace perf_usm
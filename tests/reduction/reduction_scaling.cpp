@@ -0,0 +1,336 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+//  Provides the reduction scaling mode, which measures reduction throughput
+//  from 2^10 to 2^28 elements and checks every result against a host reference
+//
+*******************************************************************************/
+
+#include "../common/disabled_for_test_case.h"
+#include "catch2/catch_test_macros.hpp"
+
+// FIXME: re-enable when sycl::reduction is implemented in hipSYCL and
+// ComputeCpp
+#if !SYCL_CTS_COMPILING_WITH_HIPSYCL && !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+#include "../../util/math_reference_batch.h"
+#include "../../util/usm_helper.h"
+#include "../common/benchmark.h"
+#include "reduction_common.h"
+
+#include <limits>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace reduction_scaling {
+#if !SYCL_CTS_COMPILING_WITH_HIPSYCL && !SYCL_CTS_COMPILING_WITH_COMPUTECPP
+using namespace sycl_cts;
+
+constexpr int min_size_log2{10};
+constexpr int max_size_log2{28};
+constexpr int size_log2_step{2};
+
+/** Number of elements of the span reductions */
+constexpr size_t span_size{8};
+
+/** Largest work-group size used for nd_range reductions */
+constexpr size_t max_work_group_size{256};
+
+/** Number of elements a host thread reduces at least */
+constexpr size_t host_min_chunk{size_t{1} << 16};
+
+/** @brief Reduction paths of the reduction category that are scaled
+ */
+enum class reduction_path {
+  with_identity,
+  without_identity,
+  several_reductions,
+  span
+};
+
+template <typename VariableT, typename FunctorT, reduction_path Path,
+          bool UseNdRange>
+class kernel;
+
+inline std::string path_name(reduction_path path) {
+  switch (path) {
+    case reduction_path::with_identity:
+      return "with identity";
+    case reduction_path::without_identity:
+      return "without identity";
+    case reduction_path::several_reductions:
+      return "several reductions in kernel";
+    case reduction_path::span:
+      return "span";
+  }
+  return {};
+}
+
+/** @brief Number of results the given reduction path produces
+ */
+constexpr size_t number_results(reduction_path path) {
+  switch (path) {
+    case reduction_path::several_reductions:
+      return 2;
+    case reduction_path::span:
+      return span_size;
+    default:
+      return 1;
+  }
+}
+
+/** Largest magnitude of the input values */
+constexpr int max_input_value{7};
+
+/** @brief Input values are small integers that change sign every span_size
+ *         elements. Any partial sum, in any reduction order, is at most
+ *         max_input_value times the number of reduced elements in magnitude.
+ */
+template <typename VariableT>
+VariableT input_value(size_t index) {
+  const long long magnitude = (index ^ (index >> 7)) % (max_input_value + 1);
+  const long long sign = (index / span_size) % 2 ? -1 : 1;
+  return static_cast<VariableT>(sign * magnitude);
+}
+
+/** @brief Largest number of elements whose reductions are exact in any order.
+ *
+ * Floating point types represent every integral partial sum exactly up to
+ * 2^digits. For int, the 2^28 elements of the largest size sum up to less
+ * than 2^31 in magnitude, and the unsigned types wrap around exactly.
+ */
+template <typename VariableT>
+constexpr size_t max_exact_size() {
+  if constexpr (std::is_floating_point_v<VariableT>) {
+    return (size_t{1} << std::numeric_limits<VariableT>::digits) /
+           max_input_value;
+  } else {
+    return std::numeric_limits<size_t>::max();
+  }
+}
+
+/** @brief Reduces input on the host like the given reduction path does on the
+ *         device, using one thread per hardware thread
+ */
+template <typename VariableT, typename FunctorT>
+std::vector<VariableT> get_expected_values(reduction_path path,
+                                           const std::vector<VariableT>& input) {
+  const VariableT identity = sycl::known_identity_v<FunctorT, VariableT>;
+  const size_t results = number_results(path);
+  std::vector<VariableT> expected(results, identity);
+  std::mutex mutex;
+
+  math::parallel_for_chunks(
+      input.size(), host_min_chunk, [&](size_t begin, size_t end) {
+        std::vector<VariableT> partial(results, identity);
+        for (size_t i = begin; i < end; ++i) {
+          const size_t result = (path == reduction_path::span) ? i % span_size
+                                                               : 0;
+          partial[result] = FunctorT{}(partial[result], input[i]);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t r = 0; r < results; ++r)
+          expected[r] = FunctorT{}(expected[r], partial[r]);
+      });
+
+  // The second reduction of the kernel reduces the same elements
+  if (path == reduction_path::several_reductions) expected[1] = expected[0];
+  return expected;
+}
+
+/** @brief Submits the kernel of the given reduction path over size elements
+ *  @param output Device memory of number_results(Path) elements, which is
+ *         initialized to the identity by every run
+ */
+template <typename VariableT, typename FunctorT, reduction_path Path,
+          bool UseNdRange>
+sycl::event submit(sycl::queue& queue, const VariableT* input,
+                   VariableT* output, size_t size, size_t work_group_size) {
+  return queue.submit([&](sycl::handler& cgh) {
+    using kernel_name = kernel<VariableT, FunctorT, Path, UseNdRange>;
+    const sycl::property_list properties{
+        sycl::property::reduction::initialize_to_identity{}};
+    const sycl::range<1> global_range{size};
+    const sycl::nd_range<1> nd_range{global_range,
+                                     sycl::range<1>{work_group_size}};
+
+    auto run = [&](auto body, auto... reductions) {
+      if constexpr (UseNdRange) {
+        cgh.parallel_for<kernel_name>(
+            nd_range, reductions..., [=](sycl::nd_item<1> item, auto&... r) {
+              body(item.get_global_id(0), r...);
+            });
+      } else {
+        cgh.parallel_for<kernel_name>(
+            global_range, reductions...,
+            [=](sycl::id<1> idx, auto&... r) { body(idx[0], r...); });
+      }
+    };
+
+    if constexpr (Path == reduction_path::with_identity) {
+      run([=](size_t i, auto& r) { r.combine(input[i]); },
+          sycl::reduction(output,
+                          sycl::known_identity_v<FunctorT, VariableT>,
+                          FunctorT{}, properties));
+    } else if constexpr (Path == reduction_path::without_identity) {
+      run([=](size_t i, auto& r) { r.combine(input[i]); },
+          sycl::reduction(output, FunctorT{}, properties));
+    } else if constexpr (Path == reduction_path::several_reductions) {
+      run(
+          [=](size_t i, auto& first, auto& second) {
+            first.combine(input[i]);
+            second.combine(input[size - 1 - i]);
+          },
+          sycl::reduction(output, FunctorT{}, properties),
+          sycl::reduction(output + 1, FunctorT{}, properties));
+    } else {
+      run([=](size_t i, auto& r) { r[i % span_size].combine(input[i]); },
+          sycl::reduction(sycl::span<VariableT, span_size>(output, span_size),
+                          FunctorT{}, properties));
+    }
+  });
+}
+
+/** @brief Checks the results of the given reduction path once, then measures
+ *         its throughput in elements per second
+ */
+template <typename VariableT, typename FunctorT, reduction_path Path,
+          bool UseNdRange>
+void run_path(sycl::queue& queue, const std::string& name,
+              const std::vector<VariableT>& host_input,
+              const VariableT* input, VariableT* output) {
+  const size_t size = host_input.size();
+  const size_t work_group_size = std::min(
+      max_work_group_size,
+      queue.get_device().get_info<sycl::info::device::max_work_group_size>());
+  const std::string benchmark_name = name + ", " + path_name(Path) +
+                                     (UseNdRange ? ", nd_range" : ", range") +
+                                     ", " + std::to_string(size) + " elements";
+
+  submit<VariableT, FunctorT, Path, UseNdRange>(queue, input, output, size,
+                                                work_group_size)
+      .wait_and_throw();
+  std::vector<VariableT> results(number_results(Path));
+  queue.copy(output, results.data(), results.size()).wait_and_throw();
+  const auto expected = get_expected_values<VariableT, FunctorT>(Path,
+                                                                 host_input);
+  for (size_t r = 0; r < results.size(); ++r) {
+    INFO(benchmark_name << ", result " << r);
+    CHECK(results[r] == expected[r]);
+  }
+
+  benchmark::set_work(size * sizeof(VariableT), size);
+  BENCHMARK(std::string(benchmark_name)) {
+    submit<VariableT, FunctorT, Path, UseNdRange>(queue, input, output, size,
+                                                  work_group_size)
+        .wait_and_throw();
+  };
+}
+
+template <typename VariableT, typename FunctorT>
+void run_functor(sycl::queue& queue, const std::string& name,
+                 const std::vector<VariableT>& host_input,
+                 const VariableT* input, VariableT* output) {
+  using path = reduction_path;
+  run_path<VariableT, FunctorT, path::with_identity, false>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::with_identity, true>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::without_identity, false>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::without_identity, true>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::several_reductions, false>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::several_reductions, true>(
+      queue, name, host_input, input, output);
+  run_path<VariableT, FunctorT, path::span, false>(queue, name, host_input,
+                                                    input, output);
+  run_path<VariableT, FunctorT, path::span, true>(queue, name, host_input,
+                                                   input, output);
+}
+
+/** @brief Runs all reduction paths with sycl::plus and sycl::maximum for
+ *         every size that fits into device memory and is reduced exactly
+ */
+template <typename VariableT>
+void run_test_for_type(sycl::queue& queue, const std::string& type_name) {
+  const auto device = queue.get_device();
+  const size_t max_alloc_size =
+      device.get_info<sycl::info::device::max_mem_alloc_size>();
+
+  for (int size_log2 = min_size_log2; size_log2 <= max_size_log2;
+       size_log2 += size_log2_step) {
+    const size_t size = size_t{1} << size_log2;
+    if (size > max_exact_size<VariableT>()) {
+      WARN("Skipping reductions of " << size << " " << type_name
+                                     << " elements, whose sums are not exact "
+                                        "in every reduction order");
+      break;
+    }
+    if (size * sizeof(VariableT) > max_alloc_size) {
+      WARN("Skipping reductions of " << size << " " << type_name
+                                     << " elements, they exceed the maximum "
+                                        "allocation size of the device");
+      break;
+    }
+
+    std::vector<VariableT> host_input(size);
+    math::parallel_for_chunks(size, host_min_chunk,
+                              [&](size_t begin, size_t end) {
+                                for (size_t i = begin; i < end; ++i)
+                                  host_input[i] = input_value<VariableT>(i);
+                              });
+
+    auto input =
+        usm_helper::allocate_usm_memory<sycl::usm::alloc::device, VariableT>(
+            queue, size);
+    auto output =
+        usm_helper::allocate_usm_memory<sycl::usm::alloc::device, VariableT>(
+            queue, span_size);
+    queue.copy(host_input.data(), input.get(), size).wait_and_throw();
+
+    run_functor<VariableT, sycl::plus<VariableT>>(
+        queue, type_name + ", plus", host_input, input.get(), output.get());
+    run_functor<VariableT, sycl::maximum<VariableT>>(
+        queue, type_name + ", maximum", host_input, input.get(),
+        output.get());
+  }
+}
+#endif
+
+// FIXME: re-enable when sycl::reduction is implemented in hipSYCL and
+// ComputeCpp
+DISABLED_FOR_TEST_CASE(ComputeCpp, hipSYCL)
+("reduction_scaling", "[reduction][benchmark][serial]")({
+  auto queue = sycl_cts::util::get_cts_object::queue();
+
+  if (!queue.get_device().has(sycl::aspect::usm_device_allocations)) {
+    SKIP("Device does not support USM device allocations");
+  }
+
+  SECTION("int") { run_test_for_type<int>(queue, "int"); }
+  SECTION("unsigned int") {
+    run_test_for_type<unsigned int>(queue, "unsigned int");
+  }
+  SECTION("long long int") {
+    run_test_for_type<long long int>(queue, "long long int");
+  }
+  SECTION("float") { run_test_for_type<float>(queue, "float"); }
+});
+}  // namespace reduction_scaling
@@ -112,6 +112,20 @@ struct handler {
 
 }  // namespace caller
 
+/** @brief Allocate the USM or non-USM memory for the given number of items with
+ *         the appropriate deleter
+ *  @tparam alloc Allocation type
+ */
+template <typename T, allocation alloc>
+auto allocate(sycl::queue &queue, size_t count) {
+  if constexpr (alloc == allocation::non_usm) {
+    return std::make_unique<T[]>(count);
+  } else {
+    constexpr auto kind = map_usm_allocation<alloc>();
+    return usm_helper::allocate_usm_memory<kind, T>(queue, count);
+  }
+}
+
 /** @brief Kernel for the device-side initialization of USM data
  */
 template <typename, size_t, allocation>
@@ -132,12 +146,7 @@ struct storage {
   /** @brief Allocate the USM or non-USM memory with the appropriate deleter
    */
   static auto get(sycl::queue &queue) {
-    if constexpr (alloc == allocation::non_usm) {
-      return std::make_unique<T[]>(count);
-    } else {
-      constexpr auto kind = map_usm_allocation<alloc>();
-      return usm_helper::allocate_usm_memory<kind, T>(queue, count);
-    }
+    return allocate<T, alloc>(queue, count);
   }
 
   /** @brief Allocate memory and initialize it with the value given
@@ -26,7 +26,8 @@ import argparse
 from string import Template
 sys.path.append('../common/')
 from common_python_vec import (Data, wrap_with_kernel, wrap_with_test_func,
-                               make_func_call, write_source_file)
+                               make_func_call, write_source_files,
+                               add_shards_argument)
 
 TEST_NAME = 'ALIAS'
 
@@ -46,14 +47,14 @@ def gen_alias_test(type_str, size):
     return wrap_with_test_func(TEST_NAME, type_str, string, str(size))
 
 
-def make_tests(type_str, input_file, output_file):
-    alias_test = ''
-    func_calls = ''
+def make_tests(type_str, input_file, output_file, shard_count=1):
+    alias_tests = []
+    func_calls = []
     for size in [2, 3, 4, 8, 16]:
-        alias_test += gen_alias_test(type_str, size)
-        func_calls += make_func_call(TEST_NAME, type_str, str(size))
-    write_source_file(alias_test, func_calls, TEST_NAME, input_file,
-                      output_file, type_str)
+        alias_tests.append(gen_alias_test(type_str, size))
+        func_calls.append(make_func_call(TEST_NAME, type_str, str(size)))
+    write_source_files(alias_tests, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
 def get_types():
     types = list()
@@ -82,9 +83,10 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    make_tests(args.ty, args.template, args.output)
+    make_tests(args.ty, args.template, args.output, args.shards)
 
 if __name__ == '__main__':
     main()
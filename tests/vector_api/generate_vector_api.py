@@ -27,7 +27,8 @@ from string import Template
 sys.path.append('../common/')
 from common_python_vec import (Data, ReverseData, append_fp_postfix, wrap_with_kernel,
                                wrap_with_test_func, make_func_call,
-                               write_source_file, get_types, cast_to_bool)
+                               write_source_file, write_source_files,
+                               add_shards_argument, get_types, cast_to_bool)
 
 TEST_NAME = 'API'
 
@@ -122,17 +123,18 @@ def make_optional_tests(type_str, input_file, output_file, dest, dest_type):
     write_source_file(api_checks, func_calls, TEST_NAME_OP, input_file,
                     output_file.replace('.cpp','_as_convert_to_'+dest+'.cpp'), type_str)
 
-def make_tests(type_str, input_file, output_file, target_enable):
+def make_tests(type_str, input_file, output_file, target_enable,
+               shard_count=1):
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
 
-    api_checks = ''
-    func_calls = ''
+    api_checks = []
+    func_calls = []
     for size in Data.standard_sizes:
-        api_checks += gen_checks(type_str, size)
-        func_calls += make_func_call(TEST_NAME, type_str, str(size))
-    write_source_file(api_checks, func_calls, TEST_NAME, input_file,
-                      output_file, type_str)
+        api_checks.append(gen_checks(type_str, size))
+        func_calls.append(make_func_call(TEST_NAME, type_str, str(size)))
+    write_source_files(api_checks, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
     if '64' in target_enable and not('double' in type_str):
         make_optional_tests(type_str, input_file, output_file, 'fp64',
@@ -168,9 +170,11 @@ def main():
         required=True,
         dest="target_enable",
         help='Option to generate tests for convert() and as() with double and half as target types')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    make_tests(args.ty, args.template, args.output, args.target_enable)
+    make_tests(args.ty, args.template, args.output, args.target_enable,
+               args.shards)
 
 if __name__ == '__main__':
     main()
@@ -27,7 +27,8 @@ import itertools
 from string import Template
 sys.path.append('../common/')
 from common_python_vec import (Data, ReverseData, wrap_with_kernel, wrap_with_test_func,
-                               make_func_call, write_source_file, get_types, cast_to_bool)
+                               make_func_call, write_source_files, add_shards_argument,
+                               get_types, cast_to_bool)
 
 TEST_NAME = 'CONSTRUCTORS'
 
@@ -128,7 +129,8 @@ def generate_opencl(type_str, size):
         str(size) + '>', test_string) + '#endif  // __SYCL_DEVICE_ONLY__\n'
 
 
-def generate_constructor_tests(type_str, input_file, output_file):
+def generate_constructor_tests(type_str, input_file, output_file,
+                               shard_count=1):
     """Generates a string for each constructor type containing each combination of test
     Constructor types: default, explicit, vec, opencl
     A cross section of variadic constructors are provided by the template"""
@@ -136,21 +138,19 @@ def generate_constructor_tests(type_str, input_file, output_file):
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
 
-    test_str = ''
-    test_func_str = ''
-    func_calls = ''
+    test_funcs = []
+    func_calls = []
     vector_sizes = Data.standard_sizes
     for size in vector_sizes:
-        test_str += generate_default(type_str, size)
+        test_str = generate_default(type_str, size)
         test_str += generate_explicit(type_str, size)
         test_str += generate_vec(type_str, size)
-        test_func_str += wrap_with_test_func(TEST_NAME, type_str,
-                                             test_str, str(size))
-        test_str = ''
-        func_calls += make_func_call(TEST_NAME, type_str, str(size))
+        test_funcs.append(wrap_with_test_func(TEST_NAME, type_str,
+                                              test_str, str(size)))
+        func_calls.append(make_func_call(TEST_NAME, type_str, str(size)))
 
-        write_source_file(test_func_str, func_calls, TEST_NAME, input_file,
-                          output_file, type_str)
+    write_source_files(test_funcs, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
 def main():
     argparser = argparse.ArgumentParser(
@@ -171,9 +171,11 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    generate_constructor_tests(args.ty, args.template, args.output)
+    generate_constructor_tests(args.ty, args.template, args.output,
+                               args.shards)
 
 
 if __name__ == '__main__':
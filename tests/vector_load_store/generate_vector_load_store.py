@@ -26,7 +26,8 @@ import argparse
 from string import Template
 sys.path.append('../common/')
 from common_python_vec import (Data, append_fp_postfix, make_func_call,
-                               wrap_with_test_func, write_source_file,
+                               wrap_with_test_func, write_source_files,
+                               add_shards_argument,
                                wrap_with_extension_checks, get_types,
                                remove_namespaces_whitespaces, cast_to_bool)
 
@@ -106,17 +107,17 @@ def gen_load_store_test(type_str, size):
                                    type_str, test_string), str(size))
 
 
-def make_tests(type_str, input_file, output_file):
+def make_tests(type_str, input_file, output_file, shard_count=1):
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
 
-    test_string = ''
-    func_calls = ''
+    tests = []
+    func_calls = []
     for size in Data.standard_sizes:
-        test_string += gen_load_store_test(type_str, size)
-        func_calls += make_func_call(TEST_NAME, type_str, str(size))
-    write_source_file(test_string, func_calls, TEST_NAME, input_file,
-                      output_file, type_str)
+        tests.append(gen_load_store_test(type_str, size))
+        func_calls.append(make_func_call(TEST_NAME, type_str, str(size)))
+    write_source_files(tests, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
 def main():
     argparser = argparse.ArgumentParser(
@@ -137,9 +138,10 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    make_tests(args.ty, args.template, args.output)
+    make_tests(args.ty, args.template, args.output, args.shards)
 
 
 if __name__ == '__main__':
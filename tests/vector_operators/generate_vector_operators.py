@@ -27,7 +27,8 @@ from string import Template
 sys.path.append('../common/')
 from common_python_vec import (Data, ReverseData, wrap_with_kernel,
                                wrap_with_test_func, make_func_call,
-                               write_source_file, get_types, cast_to_bool)
+                               write_source_files, add_shards_argument,
+                               get_types, cast_to_bool)
 
 TEST_NAME = 'OPERATORS'
 
@@ -1263,40 +1264,41 @@ def generate_non_fp_arithmetic_test(type_str, size):
         str(size) + '>', test_string)
 
 
-def generate_operator_tests(type_str, input_file, output_file):
+def generate_operator_tests(type_str, input_file, output_file,
+                            shard_count=1):
     """"""
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
-    test_func_str = ''
-    func_calls = ''
+    test_funcs = []
+    func_calls = []
     for size in Data.standard_sizes:
         test_str = generate_all_type_test(type_str, size)
-        test_func_str += wrap_with_test_func(TEST_NAME + '_ALL_TYPES',
-                                             type_str, test_str, str(size))
-        func_calls += make_func_call(TEST_NAME + '_ALL_TYPES', type_str,
-                                     str(size))
+        test_funcs.append(wrap_with_test_func(TEST_NAME + '_ALL_TYPES',
+                                              type_str, test_str, str(size)))
+        func_calls.append(make_func_call(TEST_NAME + '_ALL_TYPES', type_str,
+                                         str(size)))
         if not type_str in [
                 'float', 'double', 'sycl::half'
         ]:
             test_str = generate_non_fp_assignment_test(type_str, size)
-            test_func_str += wrap_with_test_func(
+            test_funcs.append(wrap_with_test_func(
                 TEST_NAME + '_NON_FP_ASSIGNMENT', type_str, test_str,
-                str(size))
-            func_calls += make_func_call(TEST_NAME + '_NON_FP_ASSIGNMENT',
-                                         type_str, str(size))
+                str(size)))
+            func_calls.append(make_func_call(TEST_NAME + '_NON_FP_ASSIGNMENT',
+                                             type_str, str(size)))
             test_str = generate_non_fp_bitwise_test(type_str, size)
-            test_func_str += wrap_with_test_func(TEST_NAME + '_NON_FP_BITWISE',
-                                                 type_str, test_str, str(size))
-            func_calls += make_func_call(TEST_NAME + '_NON_FP_BITWISE',
-                                         type_str, str(size))
+            test_funcs.append(wrap_with_test_func(
+                TEST_NAME + '_NON_FP_BITWISE', type_str, test_str, str(size)))
+            func_calls.append(make_func_call(TEST_NAME + '_NON_FP_BITWISE',
+                                             type_str, str(size)))
             test_str = generate_non_fp_arithmetic_test(type_str, size)
-            test_func_str += wrap_with_test_func(
+            test_funcs.append(wrap_with_test_func(
                 TEST_NAME + '_NON_FP_ARITHMETIC', type_str, test_str,
-                str(size))
-            func_calls += make_func_call(TEST_NAME + '_NON_FP_ARITHMETIC',
-                                         type_str, str(size))
-    write_source_file(test_func_str, func_calls, TEST_NAME, input_file,
-                      output_file, type_str)
+                str(size)))
+            func_calls.append(make_func_call(TEST_NAME + '_NON_FP_ARITHMETIC',
+                                             type_str, str(size)))
+    write_source_files(test_funcs, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
 def main():
     argparser = argparse.ArgumentParser(
@@ -1317,9 +1319,10 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    generate_operator_tests(args.ty, args.template, args.output)
+    generate_operator_tests(args.ty, args.template, args.output, args.shards)
 
 
 if __name__ == '__main__':
@@ -28,7 +28,8 @@ from itertools import permutations
 sys.path.append('../common/')
 from common_python_vec import (
     Data, swap_pairs, generate_value_list, append_fp_postfix, wrap_with_kernel,
-    wrap_with_test_func, make_func_call, write_source_file, get_types, cast_to_bool)
+    wrap_with_test_func, make_func_call, write_source_files,
+    add_shards_argument, get_types, cast_to_bool)
 
 TEST_NAME = 'SWIZZLE_ASSIGNMENT'
 
@@ -229,17 +230,17 @@ def gen_test(type_str, size):
     return wrap_with_test_func(TEST_NAME, type_str, string, str(size))
 
 
-def make_tests(type_str, input_file, output_file):
+def make_tests(type_str, input_file, output_file, shard_count=1):
     if type_str == 'bool':
         Data.vals_list_dict = cast_to_bool(Data.vals_list_dict)
 
-    test_str = ''
-    func_calls = ''
+    tests = []
+    func_calls = []
     for size in Data.standard_sizes:
-        test_str += gen_test(type_str, size)
-        func_calls += make_func_call(TEST_NAME, type_str, str(size))
-    write_source_file(test_str, func_calls, TEST_NAME, input_file,
-                      output_file, type_str)
+        tests.append(gen_test(type_str, size))
+        func_calls.append(make_func_call(TEST_NAME, type_str, str(size)))
+    write_source_files(tests, func_calls, TEST_NAME, input_file,
+                       output_file, type_str, shard_count)
 
 def main():
     argparser = argparse.ArgumentParser(
@@ -260,9 +261,10 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    make_tests(args.ty, args.template, args.output)
+    make_tests(args.ty, args.template, args.output, args.shards)
 
 
 if __name__ == '__main__':
@@ -25,7 +25,8 @@ import sys
 import argparse
 from string import Template
 sys.path.append('../common/')
-from common_python_vec import (get_types, make_swizzles_tests)
+from common_python_vec import (get_types, make_swizzles_tests,
+                               add_shards_argument)
 
 def main():
     argparser = argparse.ArgumentParser(
@@ -46,9 +47,10 @@ def main():
         dest="output",
         metavar='<out file>',
         help='CTS test output')
+    add_shards_argument(argparser)
     args = argparser.parse_args()
 
-    make_swizzles_tests(args.ty, args.template, args.output)
+    make_swizzles_tests(args.ty, args.template, args.output, args.shards)
 
 
 if __name__ == '__main__':
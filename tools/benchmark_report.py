@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+
+"""
+Prints the results written by the '--benchmark-json' option of the test
+executables as a throughput table, one table per test case section.
+
+Examples:
+  benchmark_report.py perf_atomic.json
+  benchmark_report.py perf_atomic.json --filter 'fetch_add'
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def format_time(ns):
+    for (unit, scale) in (('s', 1e9), ('ms', 1e6), ('us', 1e3)):
+        if ns >= scale:
+            return '%.2f%s' % (ns / scale, unit)
+    return '%.1fns' % ns
+
+
+def format_rate(value, unit):
+    for (prefix, scale) in (('G', 1e9), ('M', 1e6), ('k', 1e3)):
+        if value >= scale:
+            return '%.2f%s%s' % (value / scale, prefix, unit)
+    return '%.2f%s' % (value, unit)
+
+
+def print_table(header, rows):
+    widths = [max(len(str(row[i])) for row in [header] + rows)
+              for i in range(len(header))]
+    for row in [header] + rows:
+        print('  '.join(str(cell).rjust(width) if i + 1 < len(row) else str(cell)
+                        for (i, (cell, width)) in enumerate(zip(row, widths))))
+    print()
+
+
+def main(argv=sys.argv[1:]):
+    parser = argparse.ArgumentParser(
+        description='Prints benchmark results of the CTS as tables')
+    parser.add_argument('results', help='File written by --benchmark-json')
+    parser.add_argument('--filter',
+                        metavar='REGEX',
+                        help='Only show benchmarks whose name matches REGEX')
+    args = parser.parse_args(argv)
+
+    with open(args.results, 'r') as results_file:
+        results = json.load(results_file)
+
+    print('Device: %s (%s), driver %s' %
+          (results.get('device-name'), results.get('device-vendor'),
+           results.get('driver-version')))
+    print()
+
+    tables = {}
+    for benchmark in results.get('benchmarks', []):
+        if args.filter and not re.search(args.filter, benchmark['name']):
+            continue
+        title = benchmark['test-case']
+        if benchmark.get('section'):
+            title += ' / ' + benchmark['section']
+        tables.setdefault(title, []).append(benchmark)
+
+    for (title, benchmarks) in tables.items():
+        print(title + ':')
+        print_table(['mean', 'std-dev', 'items/s', 'bytes/s', 'benchmark'],
+                    [[format_time(b['mean-ns']),
+                      format_time(b['std-dev-ns']),
+                      format_rate(b['items-per-second'], '')
+                      if 'items-per-second' in b else '-',
+                      format_rate(b['bytes-per-second'], 'B')
+                      if 'bytes-per-second' in b else '-', b['name']]
+                     for b in benchmarks])
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+
+"""
+Analyzes the 'build_times.jsonl' file written when building with
+SYCL_CTS_MEASURE_BUILD_TIMES=ON.
+
+Examples:
+  build_time_report.py build/build_times.jsonl
+  build_time_report.py build/build_times.jsonl --top 50 --sort peak_rss
+  build_time_report.py new/build_times.jsonl --diff old/build_times.jsonl
+"""
+
+import argparse
+import json
+import os
+import sys
+
+METRICS = ['wall_time', 'peak_rss', 'object_size', 'template_instantiations']
+
+
+def load_records(filename):
+    """
+    Loads the records of a build, keyed by object file. If a translation unit
+    was built several times, the most recent record is used.
+    """
+    records = {}
+    with open(filename, 'r') as records_file:
+        for line in records_file:
+            line = line.strip()
+            if line:
+                record = json.loads(line)
+                records[record['object']] = record
+    return records
+
+
+def get_category(record):
+    """
+    Returns the test category of a translation unit, e.g. 'accessor' for
+    'tests/accessor/accessor_api.cpp', or the top level directory for sources
+    outside of 'tests'.
+    """
+    parts = os.path.normpath(record['source']).split(os.sep)
+    parts = [p for p in parts if p not in ('..', '.')]
+    if 'tests' in parts and parts.index('tests') + 2 < len(parts):
+        return parts[parts.index('tests') + 1]
+    return parts[0] if len(parts) > 1 else '(root)'
+
+
+def format_value(metric, value):
+    if value is None:
+        return '-'
+    if metric == 'wall_time':
+        return '%.1fs' % value
+    if metric in ('peak_rss', 'object_size'):
+        return '%.1fMB' % (value / (1024 * 1024))
+    return str(value)
+
+
+def print_table(header, rows):
+    widths = [max(len(str(row[i])) for row in [header] + rows)
+              for i in range(len(header))]
+    for row in [header] + rows:
+        print('  '.join(str(cell).rjust(width) if i + 1 < len(row) else str(cell)
+                        for (i, (cell, width)) in enumerate(zip(row, widths))))
+    print()
+
+
+def report_translation_units(records, metric, top):
+    print('Slowest translation units by %s:' % metric)
+    ranked = sorted(records.values(),
+                    key=lambda r: r.get(metric) or 0, reverse=True)[:top]
+    print_table(METRICS + ['source'],
+                [[format_value(m, r.get(m)) for m in METRICS] + [r['source']]
+                 for r in ranked])
+
+
+def report_categories(records):
+    print('Totals by test category:')
+    totals = {}
+    for record in records.values():
+        category = totals.setdefault(get_category(record), {
+            'count': 0,
+            'wall_time': 0.0,
+            'peak_rss': 0
+        })
+        category['count'] += 1
+        category['wall_time'] += record.get('wall_time') or 0.0
+        category['peak_rss'] = max(category['peak_rss'],
+                                   record.get('peak_rss') or 0)
+    ranked = sorted(totals.items(), key=lambda c: c[1]['wall_time'],
+                    reverse=True)
+    print_table(['wall_time', 'max_peak_rss', 'TUs', 'category'],
+                [[format_value('wall_time', c['wall_time']),
+                  format_value('peak_rss', c['peak_rss']), c['count'], name]
+                 for (name, c) in ranked])
+
+
+def report_headers(records, top):
+    headers = {}
+    for record in records.values():
+        for (header, seconds) in record.get('headers', {}).items():
+            entry = headers.setdefault(header, [0.0, 0])
+            entry[0] += seconds
+            entry[1] += 1
+    if not headers:
+        return
+    print('Most expensive headers (summed over all translation units):')
+    ranked = sorted(headers.items(), key=lambda h: h[1][0], reverse=True)[:top]
+    print_table(['wall_time', 'TUs', 'header'],
+                [[format_value('wall_time', h[1][0]), h[1][1], h[0]]
+                 for h in ranked])
+
+
+def report_diff(records, baseline, metric, top):
+    print('Largest changes in %s compared to the baseline:' % metric)
+    changes = []
+    for (obj, record) in records.items():
+        if obj not in baseline:
+            continue
+        new = record.get(metric)
+        old = baseline[obj].get(metric)
+        if new is None or old is None:
+            continue
+        changes.append((new - old, old, new, record['source']))
+    changes.sort(key=lambda c: abs(c[0]), reverse=True)
+    print_table(['change', 'baseline', 'current', 'source'],
+                [[('+' if c[0] >= 0 else '-') +
+                  format_value(metric, abs(c[0])),
+                  format_value(metric, c[1]),
+                  format_value(metric, c[2]), c[3]] for c in changes[:top]])
+
+    added = sorted(set(records) - set(baseline))
+    removed = sorted(set(baseline) - set(records))
+    if added:
+        print('Only in current build: ' + ', '.join(added))
+    if removed:
+        print('Only in baseline build: ' + ', '.join(removed))
+
+    total_new = sum(r.get('wall_time') or 0.0 for r in records.values())
+    total_old = sum(r.get('wall_time') or 0.0 for r in baseline.values())
+    print('Total wall time: %s (baseline %s)' %
+          (format_value('wall_time', total_new),
+           format_value('wall_time', total_old)))
+
+
+def main(argv=sys.argv[1:]):
+    parser = argparse.ArgumentParser(
+        description='Reports build time measurements of the CTS')
+    parser.add_argument('records',
+                        help='build_times.jsonl file of the build to analyze')
+    parser.add_argument('--diff',
+                        metavar='BASELINE',
+                        help='build_times.jsonl file of a build to compare with')
+    parser.add_argument('--sort',
+                        choices=METRICS,
+                        default='wall_time',
+                        help='Metric used to rank translation units')
+    parser.add_argument('--top',
+                        type=int,
+                        default=20,
+                        help='Number of entries to show per ranking')
+    args = parser.parse_args(argv)
+
+    records = load_records(args.records)
+    if args.diff:
+        report_diff(records, load_records(args.diff), args.sort, args.top)
+        return 0
+
+    report_translation_units(records, args.sort, args.top)
+    report_categories(records)
+    report_headers(records, args.top)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
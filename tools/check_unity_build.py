@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+
+"""
+Utility script used by CMake when SYCL_CTS_UNITY_BUILD_BATCH_SIZE is set.
+Not intended for manual use.
+
+Unity builds concatenate several test sources into a single translation unit.
+Names that each source defines at namespace scope, in particular inside
+anonymous namespaces (such as helpers next to `once_per_unit`) or through the
+per-file TEST_NAME macro, then clash with each other. This script performs a
+lightweight scan of the given sources and prints every source that defines a
+class, struct, enum, alias or variable with the same qualified name as a
+previously listed source, so that CMake can exclude it from the unity build.
+Functions clash if their qualified names, template parameters and parameter
+types match, as overloads with other parameters are legitimate.
+
+Macros that a source defines and does not undefine again, such as the index
+of the translation unit in the spec constant linking tests, leak into the
+following sources and clash as well. The exception is TEST_NAME, which most
+sources define without undefining it, so CMake undefines it after each source
+of a unity translation unit instead.
+"""
+
+import re
+import sys
+
+TOKEN_RE = re.compile(r'[A-Za-z_]\w*|::|\S')
+DEFINE_RE = re.compile(r'^\s*#\s*define\s+(\w+)\s+(\w+)\s*$', re.MULTILINE)
+MACRO_RE = re.compile(r'^\s*#\s*(define|undef)\s+(\w+)', re.MULTILINE)
+IDENTIFIER_RE = re.compile(r'[A-Za-z_]\w*$')
+# Keywords that end a parameter type instead of naming the parameter
+TYPE_KEYWORDS = {
+    'bool', 'char', 'char16_t', 'char32_t', 'double', 'float', 'int', 'long',
+    'short', 'signed', 'unsigned', 'void', 'wchar_t', 'auto'
+}
+
+
+def strip_source(source):
+    """
+    Removes comments, string literals and preprocessor directives.
+    """
+    source = re.sub(r'//[^\n]*|/\*.*?\*/', ' ', source, flags=re.DOTALL)
+    source = re.sub(r'"(\\.|[^"\\])*"|\'(\\.|[^\'\\])*\'', '""', source)
+    # Join continued lines so that multi-line macros are dropped completely
+    source = source.replace('\\\n', ' ')
+    return re.sub(r'^\s*#[^\n]*', ' ', source, flags=re.MULTILINE)
+
+
+def find_closing(tokens, i, opening, closing):
+    """
+    Returns the index of the token closing the bracket opened at tokens[i].
+    """
+    depth = 0
+    for j in range(i, len(tokens)):
+        if tokens[j] == opening:
+            depth += 1
+        elif tokens[j] == closing:
+            depth -= 1
+            if depth == 0:
+                return j
+    return len(tokens)
+
+
+def split_parameters(tokens):
+    """
+    Splits the tokens of a parameter list at the top-level commas.
+    """
+    parameters = [[]]
+    depth = 0
+    for token in tokens:
+        if token in ('(', '<', '[', '{'):
+            depth += 1
+        elif token in (')', '>', ']', '}'):
+            depth -= 1
+        elif token == ',' and depth == 0:
+            parameters.append([])
+            continue
+        parameters[-1].append(token)
+    return [p for p in parameters if p]
+
+
+def parameter_type(tokens):
+    """
+    Returns the type of a parameter declaration, without its name and default
+    argument.
+    """
+    if '=' in tokens:
+        tokens = tokens[:tokens.index('=')]
+    if len(tokens) > 1 and IDENTIFIER_RE.match(tokens[-1]) and \
+            tokens[-1] not in TYPE_KEYWORDS and \
+            tokens[-2] not in ('::', 'const', 'volatile', 'typename',
+                               'class', 'struct', 'enum'):
+        tokens = tokens[:-1]
+    return ' '.join(tokens)
+
+
+def get_function_signature(tokens, i):
+    """
+    Returns the name and parameter types of the function defined by the
+    statement starting at tokens[i], or None if the statement is no function
+    definition. Statements without a return type, such as the TEST_CASE
+    macros, are not considered.
+    """
+    j = i
+    while j < len(tokens) and tokens[j] not in (';', '{', '}', '(', '='):
+        j += 1
+    if j >= len(tokens) or tokens[j] != '(' or j - 1 <= i or \
+            not IDENTIFIER_RE.match(tokens[j - 1]) or \
+            tokens[j - 1] in ('operator', 'decltype') or \
+            tokens[j - 2] == 'operator':
+        return None
+    end = find_closing(tokens, j, '(', ')')
+    k = end + 1
+    while k < len(tokens) and tokens[k] not in ('{', ';', '=', ':'):
+        if tokens[k] == '(':
+            k = find_closing(tokens, k, '(', ')')
+        k += 1
+    if k >= len(tokens) or tokens[k] != '{':
+        return None
+    parameters = [parameter_type(p)
+                  for p in split_parameters(tokens[j + 1:end])]
+    if parameters == ['void']:
+        parameters = []
+    return '%s(%s)' % (tokens[j - 1], ', '.join(parameters))
+
+
+def get_definitions(filename):
+    """
+    Returns the qualified names defined at namespace scope in a source file.
+    Names in anonymous namespaces are qualified with '(anonymous)'.
+    """
+    with open(filename, 'r', errors='replace') as source_file:
+        source = source_file.read()
+
+    # Resolve simple object-like macros such as TEST_NAME, which differ
+    # between the sources
+    macros = dict(DEFINE_RE.findall(source.replace('\\\n', ' ')))
+    for _ in range(2):
+        macros = {k: macros.get(v, v) for (k, v) in macros.items()}
+    if 'TEST_NAME' in macros:
+        macros['TEST_NAMESPACE'] = macros['TEST_NAME'] + '__'
+
+    tokens = [macros.get(t, t) for t in TOKEN_RE.findall(strip_source(source))]
+
+    definitions = set()
+    defined_macros = set()
+    for (directive, name) in MACRO_RE.findall(source):
+        if directive == 'define':
+            defined_macros.add(name)
+        else:
+            defined_macros.discard(name)
+    defined_macros.discard('TEST_NAME')
+    definitions.update('#define ' + name for name in defined_macros)
+    # Stack of scopes; namespace scopes carry their name, other scopes None
+    scopes = []
+    at_namespace_scope = lambda: all(s is not None for s in scopes)
+    statement_start = True
+    template_depth = 0
+    # Template parameter list of the current statement
+    template_parameters = ''
+    i = 0
+    while i < len(tokens):
+        token = tokens[i]
+        if token == 'namespace' and at_namespace_scope():
+            # namespace [a::b] { or namespace alias = ...;
+            j = i + 1
+            name = []
+            while j < len(tokens) and tokens[j] not in ('{', '=', ';'):
+                if tokens[j] != '::':
+                    name.append(tokens[j])
+                j += 1
+            if j < len(tokens) and tokens[j] == '{':
+                scopes.append('::'.join(name) if name else '(anonymous)')
+                i = j + 1
+                statement_start = True
+                continue
+        if token == '{':
+            scopes.append(None)
+        elif token == '}':
+            if scopes:
+                scopes.pop()
+            statement_start = True
+        elif token == ';':
+            statement_start = True
+            template_depth = 0
+            template_parameters = ''
+        elif at_namespace_scope() and statement_start:
+            if token == 'template':
+                # Skip the template parameter list
+                j = i + 1
+                depth = 0
+                while j < len(tokens):
+                    if tokens[j] == '<':
+                        depth += 1
+                    elif tokens[j] == '>':
+                        depth -= 1
+                        if depth == 0:
+                            break
+                    j += 1
+                template_parameters += ' '.join(tokens[i:j + 1]) + ' '
+                i = j + 1
+                continue
+            name = None
+            if token in ('class', 'struct', 'union', 'enum'):
+                j = i + 1
+                if j < len(tokens) and tokens[j] in ('class', 'struct'):
+                    j += 1
+                # Skip attributes and alignas
+                while j < len(tokens) and tokens[j] in ('[', ']', 'alignas'):
+                    j += 1
+                if j + 1 < len(tokens) and tokens[j + 1] in ('{', ':', 'final'):
+                    name = tokens[j]
+                    # Specializations such as 'struct foo<int>' are not clashes
+                    # by name alone
+            elif token == 'using' and i + 2 < len(tokens) and tokens[i + 2] == '=':
+                name = tokens[i + 1]
+            elif token in ('static', 'constexpr', 'inline', 'const'):
+                # Variables: look for 'name =' or 'name{' before ';' or '('
+                j = i + 1
+                while j + 1 < len(tokens) and tokens[j + 1] not in (';', '(', '=', '{'):
+                    j += 1
+                if j + 1 < len(tokens) and tokens[j + 1] in ('=', '{') and \
+                        re.match(r'[A-Za-z_]\w*$', tokens[j]):
+                    name = tokens[j]
+            if name is None and token not in ('class', 'struct', 'union',
+                                              'enum', 'using'):
+                signature = get_function_signature(tokens, i)
+                if signature is not None:
+                    definitions.add(template_parameters +
+                                    '::'.join(scopes + [signature]))
+            if name is not None:
+                definitions.add('::'.join([s for s in scopes] + [name]))
+            statement_start = False
+            template_parameters = ''
+        i += 1
+    return definitions
+
+
+def main(argv=sys.argv[1:]):
+    defined = {}
+    for filename in argv:
+        try:
+            definitions = get_definitions(filename)
+        except OSError:
+            # Generated sources do not exist at configure time
+            continue
+        clashes = sorted(d for d in definitions if d in defined)
+        if clashes:
+            print(filename)
+            sys.stderr.write('%s: %s also defined in %s\n' %
+                             (filename, clashes[0], defined[clashes[0]]))
+            continue
+        for d in definitions:
+            defined[d] = filename
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
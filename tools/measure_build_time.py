@@ -4,8 +4,15 @@
 Utility script for measuring the build time of a translation unit.
 Not intended for manual use.
 To enable, specify SYCL_CTS_MEASURE_BUILD_TIMES=ON during CMake configuration.
+
+For every translation unit a line is appended to 'build_times.log', and a JSON
+record with the wall time, peak memory usage, object size and, if the compiler
+produced a -ftime-trace file, template instantiation counts and header parse
+times is appended to 'build_times.jsonl'. Use build_time_report.py to analyze
+the latter.
 """
 
+import json
 import os
 import subprocess
 import sys
@@ -13,11 +20,18 @@ import sys
 from pathlib import Path
 from timeit import default_timer as timer
 
+try:
+    import resource
+except ImportError:
+    # Not available on Windows
+    resource = None
+
 args = sys.argv[1:]
 
 # We assume arguments to end with '-o <object file> -c <source file>'
 # FIXME: This may not work with MSVC
-obj_file = os.path.basename(args[-3])
+obj_path = args[-3]
+obj_file = os.path.basename(obj_path)
 src_file = args[-1]
 
 # Locate build root: The compiler may not always be launched directly from
@@ -33,11 +47,80 @@ for p in [build_root] + list(build_root.parents):
 # Make source file path relative to build directory
 src_file = os.path.relpath(src_file, build_root)
 
+
+def get_peak_rss_bytes():
+    """
+    Returns the peak resident set size of the compiler process, or None if it
+    cannot be determined on this platform.
+    """
+    if resource is None:
+        return None
+    max_rss = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    # Linux reports kilobytes, macOS bytes
+    return max_rss if sys.platform == 'darwin' else max_rss * 1024
+
+
+def read_time_trace(trace_file):
+    """
+    Extracts template instantiation counts and per-header parse times from a
+    Clang -ftime-trace file.
+    """
+    with open(trace_file, 'r') as trace:
+        events = json.load(trace).get('traceEvents', [])
+
+    instantiations = 0
+    headers = {}
+    for event in events:
+        name = event.get('name')
+        if name in ('InstantiateClass', 'InstantiateFunction'):
+            instantiations += 1
+        elif name == 'Source':
+            header = event.get('args', {}).get('detail')
+            if header:
+                headers[header] = headers.get(header, 0) + event.get('dur', 0)
+    # Durations are given in microseconds
+    return instantiations, {h: d / 1e6 for (h, d) in headers.items()}
+
+
+# Clang places the trace next to the object file. Remove the one of an earlier
+# build, a failed compile would otherwise leave it to be read below.
+trace_file = os.path.splitext(obj_path)[0] + '.json'
+try:
+    os.remove(trace_file)
+except OSError:
+    pass
+
 ts_before = timer()
-subprocess.run(' '.join(args), shell=True)
+result = subprocess.run(args)
 ts_after = timer()
 dt = ts_after - ts_before
 
 with open(build_root / "build_times.log", "a") as output_file:
     print(f"{dt:.1f} {obj_file} ({src_file})",
           file=output_file)
+
+record = {
+    'source': src_file,
+    'object': os.path.relpath(obj_path, build_root),
+    'wall_time': round(dt, 3),
+    'peak_rss': get_peak_rss_bytes(),
+    'object_size':
+    os.path.getsize(obj_path) if os.path.isfile(obj_path) else None,
+    'template_instantiations': None,
+    'headers': {},
+}
+
+# Only use a trace written by this compile, it is written after the object
+if (result.returncode == 0 and os.path.isfile(trace_file)
+        and os.path.isfile(obj_path)
+        and os.path.getmtime(trace_file) >= os.path.getmtime(obj_path)):
+    try:
+        (record['template_instantiations'],
+         record['headers']) = read_time_trace(trace_file)
+    except (ValueError, OSError):
+        pass
+
+with open(build_root / "build_times.jsonl", "a") as output_file:
+    print(json.dumps(record), file=output_file)
+
+sys.exit(result.returncode)
@@ -0,0 +1,114 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "benchmark_results.h"
+
+#include "device_manager.h"
+#include "json.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+
+namespace sycl_cts {
+namespace util {
+
+void benchmark_results::add(benchmark_record record) {
+  if (m_bytes && *m_bytes > 0) record.bytes = m_bytes;
+  if (m_items && *m_items > 0) record.items = m_items;
+  m_bytes.reset();
+  m_items.reset();
+  m_records.push_back(std::move(record));
+}
+
+void benchmark_results::add_derived(const std::string& name,
+                                    const std::vector<double>& samplesNs) {
+  if (samplesNs.empty() || m_records.empty()) return;
+  const double n = static_cast<double>(samplesNs.size());
+  const double mean =
+      std::accumulate(samplesNs.begin(), samplesNs.end(), 0.0) / n;
+  double variance = 0;
+  for (const double sample : samplesNs) {
+    variance += (sample - mean) * (sample - mean);
+  }
+  variance /= n > 1 ? n - 1 : 1;
+  const double stdDev = std::sqrt(variance);
+  // 95% confidence interval of the mean, assuming a normal distribution
+  const double margin = 1.96 * stdDev / std::sqrt(n);
+
+  benchmark_record record;
+  record.testCase = m_records.back().testCase;
+  record.section = m_records.back().section;
+  record.name = name;
+  record.meanNs = mean;
+  record.meanLowerNs = mean - margin;
+  record.meanUpperNs = mean + margin;
+  record.stdDevNs = stdDev;
+  record.samples = samplesNs.size();
+  record.iterations = 1;
+  m_records.push_back(std::move(record));
+}
+
+void benchmark_results::write() const {
+  if (m_outputFile.empty() || m_records.empty()) return;
+
+  const auto device = get<device_manager>().get_device();
+  const auto platform = device.get_platform();
+
+  std::ofstream out(m_outputFile);
+  out << std::setprecision(17);
+  out << "{\n  \"device-name\": "
+      << json_string(device.get_info<sycl::info::device::name>())
+      << ",\n  \"device-vendor\": "
+      << json_string(device.get_info<sycl::info::device::vendor>())
+      << ",\n  \"driver-version\": "
+      << json_string(device.get_info<sycl::info::device::driver_version>())
+      << ",\n  \"platform-name\": "
+      << json_string(platform.get_info<sycl::info::platform::name>())
+      << ",\n  \"platform-version\": "
+      << json_string(platform.get_info<sycl::info::platform::version>())
+      << ",\n  \"benchmarks\": [";
+  for (size_t i = 0; i < m_records.size(); ++i) {
+    const auto& r = m_records[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"test-case\": "
+        << json_string(r.testCase) << ", \"section\": "
+        << json_string(r.section) << ", \"name\": " << json_string(r.name)
+        << ", \"mean-ns\": " << r.meanNs
+        << ", \"mean-lower-ns\": " << r.meanLowerNs
+        << ", \"mean-upper-ns\": " << r.meanUpperNs
+        << ", \"std-dev-ns\": " << r.stdDevNs
+        << ", \"samples\": " << r.samples
+        << ", \"iterations\": " << r.iterations;
+    if (r.bytes) {
+      out << ", \"bytes\": " << *r.bytes << ", \"bytes-per-second\": "
+          << *r.bytes / (r.meanNs * 1e-9);
+    }
+    if (r.items) {
+      out << ", \"items\": " << *r.items << ", \"items-per-second\": "
+          << *r.items / (r.meanNs * 1e-9);
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+}  // namespace util
+}  // namespace sycl_cts
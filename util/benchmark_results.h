@@ -0,0 +1,107 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_BENCHMARK_RESULTS_H
+#define __SYCLCTS_UTIL_BENCHMARK_RESULTS_H
+
+#include "singleton.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Result of a single Catch2 BENCHMARK, with all durations in nanoseconds.
+ */
+struct benchmark_record {
+  std::string testCase;
+  std::string section;
+  std::string name;
+  double meanNs = 0;
+  double meanLowerNs = 0;
+  double meanUpperNs = 0;
+  double stdDevNs = 0;
+  size_t samples = 0;
+  int iterations = 0;
+  /** Bytes transferred by one run of the benchmark, if set */
+  std::optional<double> bytes;
+  /** Work items (elements, kernels, operations) of one run, if set */
+  std::optional<double> items;
+};
+
+/**
+ * Collects the results of all benchmarks of a run and writes them as JSON to
+ * the file given with the `--benchmark-json` CLI parameter, so that they can
+ * be compared across runs and SYCL implementations.
+ */
+class benchmark_results : public singleton<benchmark_results> {
+ public:
+  void set_output_file(const std::string& outputFile) {
+    m_outputFile = outputFile;
+  }
+
+  /**
+   * Sets the amount of work done by one run of the next benchmark to finish,
+   * from which its throughput is computed. Either value may be zero if it
+   * does not apply.
+   */
+  void set_work(double bytes, double items) {
+    m_bytes = bytes;
+    m_items = items;
+  }
+
+  /**
+   * Stores the result of a benchmark, together with the work set for it.
+   */
+  void add(benchmark_record record);
+
+  /**
+   * Stores a result derived from the last benchmark, such as the duration of
+   * one phase of its runs, under the test case and section of that benchmark.
+   * Does nothing if there are no samples or no benchmark has finished yet.
+   */
+  void add_derived(const std::string& name,
+                   const std::vector<double>& samplesNs);
+
+  /**
+   * Writes all stored results to the output file, if one was set and there
+   * is at least one result.
+   */
+  void write() const;
+
+  /**
+   * Drops all stored results, as cts_server runs several sessions.
+   */
+  void clear() { m_records.clear(); }
+
+ private:
+  std::string m_outputFile;
+  std::optional<double> m_bytes;
+  std::optional<double> m_items;
+  std::vector<benchmark_record> m_records;
+};
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_BENCHMARK_RESULTS_H
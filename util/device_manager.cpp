@@ -23,8 +23,6 @@
 
 #include <fstream>
 
-#include "../tests/common/cts_selector.h"
-
 namespace sycl_cts {
 namespace util {
 
@@ -51,9 +49,34 @@ static std::string get_device_type_str(const sycl::device& d) {
   };
 }
 
-void device_manager::list_devices() const {
+const sycl::device& device_manager::get_device() {
+  // An exception leaves the flag unset, so the selection is tried again
+  std::call_once(selected_device_flag, [this] {
+    if (!device_regex.has_value()) {
+      selected_device = sycl::device(sycl::default_selector_v);
+      return;
+    }
+
+    for (const auto& d : sycl::device::get_devices()) {
+      const auto platform_name =
+          d.get_platform().get_info<sycl::info::platform::name>();
+      const auto device_name = d.get_info<sycl::info::device::name>();
+      if (std::regex_search(platform_name + " / " + device_name,
+                            *device_regex)) {
+        selected_device = d;
+        return;
+      }
+    }
+
+    throw sycl::exception(sycl::make_error_code(sycl::errc::runtime),
+                          "No device matches the regex given by --device");
+  });
+  return *selected_device;
+}
+
+void device_manager::list_devices() {
   const auto all_devices = sycl::device::get_devices();
-  const auto cts_device = sycl::device(cts_selector);
+  const auto cts_device = get_device();
 
   if (all_devices.empty()) {
     printf("No devices available.\n");
@@ -75,8 +98,8 @@ void device_manager::list_devices() const {
 }
 
 void device_manager::dump_info(const std::string& infoDumpFile) {
-  auto chosenDevice = sycl::device(cts_selector);
-  auto chosenPlatform = sycl::platform(cts_selector);
+  auto chosenDevice = get_device();
+  auto chosenPlatform = chosenDevice.get_platform();
 
   std::fstream infoFile(infoDumpFile, std::ios::out);
 
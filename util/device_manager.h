@@ -22,8 +22,11 @@
 #ifndef __SYCLCTS_UTIL_TEST_MANAGER_H
 #define __SYCLCTS_UTIL_TEST_MANAGER_H
 
+#include <sycl/sycl.hpp>
+
 #include "singleton.h"
 
+#include <mutex>
 #include <optional>
 #include <regex>
 
@@ -32,6 +35,10 @@ namespace util {
 
 class device_manager : public singleton<device_manager> {
  public:
+  /**
+   * Sets the regex given by the `--device` CLI parameter. Must be called
+   * before the device is first used.
+   */
   void set_device_regex(std::regex re) { device_regex = std::move(re); }
 
   /**
@@ -42,10 +49,17 @@ class device_manager : public singleton<device_manager> {
     return device_regex;
   }
 
+  /**
+   * @return The device used for this CTS run. It is selected on first use,
+   * either by matching the `--device` regex or by the SYCL default selector,
+   * and kept for the rest of the run. Safe to call from multiple threads.
+   */
+  const sycl::device& get_device();
+
   /**
    * Lists all available devices, indicating the currently selected one.
    */
-  void list_devices() const;
+  void list_devices();
 
   /**
    * Dumps information about the device used for this CTS run to a
@@ -55,6 +69,8 @@ class device_manager : public singleton<device_manager> {
 
  private:
   std::optional<std::regex> device_regex;
+  std::once_flag selected_device_flag;
+  std::optional<sycl::device> selected_device;
 };
 
 }  // namespace util
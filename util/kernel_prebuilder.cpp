@@ -0,0 +1,133 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "kernel_prebuilder.h"
+
+#include "../tests/common/cts_async_handler.h"
+#include "device_manager.h"
+#include "sycl_object_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace sycl_cts {
+namespace util {
+
+void kernel_prebuilder::prebuild(unsigned threads, std::ostream& out) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_done) return;
+  m_done = true;
+
+// ComputeCpp and hipSYCL do not yet support sycl::get_kernel_bundle
+#if !SYCL_CTS_COMPILING_WITH_COMPUTECPP && !SYCL_CTS_COMPILING_WITH_HIPSYCL
+  using exe_bundle = sycl::kernel_bundle<sycl::bundle_state::executable>;
+
+  const auto start = std::chrono::steady_clock::now();
+  const sycl::device& device = get<device_manager>().get_device();
+  std::vector<sycl::context> contexts{get<sycl_object_cache>().context()};
+  const auto defaultContext =
+      sycl::queue(device, cts_async_handler{}).get_context();
+  if (defaultContext != contexts.front()) contexts.push_back(defaultContext);
+
+  // Kernels of one translation unit usually share a device image, so each
+  // image is built once, by a task for the kernels it contains
+  const auto kernelIds = sycl::get_kernel_ids();
+  std::vector<std::pair<sycl::context, std::vector<sycl::kernel_id>>> tasks;
+  size_t unsupported = 0;
+  for (const auto& context : contexts) {
+    // Kernels using optional features the device lacks are left out, and
+    // ahead-of-time compiled kernels need no build
+    std::optional<sycl::kernel_bundle<sycl::bundle_state::input>> input;
+    try {
+      input = sycl::get_kernel_bundle<sycl::bundle_state::input>(context,
+                                                                 {device});
+    } catch (const sycl::exception&) {
+      unsupported += kernelIds.size();
+      continue;
+    }
+    std::set<std::vector<std::string>> images;
+    size_t covered = 0;
+    for (const auto& image : *input) {
+      std::vector<sycl::kernel_id> ids;
+      std::vector<std::string> names;
+      for (const auto& id : kernelIds) {
+        if (!image.has_kernel(id, device)) continue;
+        ids.push_back(id);
+        names.push_back(id.get_name());
+      }
+      std::sort(names.begin(), names.end());
+      if (ids.empty() || !images.insert(std::move(names)).second) continue;
+      covered += ids.size();
+      tasks.emplace_back(context, std::move(ids));
+    }
+    unsupported += kernelIds.size() - std::min(covered, kernelIds.size());
+  }
+
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  if (tasks.size() < threads) threads = std::max<unsigned>(tasks.size(), 1);
+
+  std::vector<std::optional<exe_bundle>> bundles(tasks.size());
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> failed{0};
+  auto work = [&] {
+    for (size_t i = next++; i < tasks.size(); i = next++) {
+      const auto& [context, ids] = tasks[i];
+      try {
+        bundles[i] = sycl::get_kernel_bundle<sycl::bundle_state::executable>(
+            context, {device}, ids);
+      } catch (const sycl::exception&) {
+        // The test submitting the kernel reports the failure
+        ++failed;
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t) pool.emplace_back(work);
+  for (auto& thread : pool) thread.join();
+
+  for (auto& bundle : bundles) {
+    if (bundle) m_bundles.push_back(std::move(*bundle));
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const auto flags = out.flags();
+  out << "Prebuilt " << m_bundles.size() << " of " << tasks.size()
+      << " device images (" << failed << " failed, " << unsupported
+      << " kernels without input image) for " << contexts.size()
+      << " contexts on " << threads << " threads in " << std::fixed
+      << std::setprecision(2) << elapsed.count() << " s\n";
+  out.flags(flags);
+#else
+  static_cast<void>(threads);
+  out << "--prebuild-kernels is not supported by this SYCL implementation\n";
+#endif
+}
+
+}  // namespace util
+}  // namespace sycl_cts
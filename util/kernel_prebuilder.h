@@ -0,0 +1,66 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_KERNEL_PREBUILDER_H
+#define __SYCLCTS_UTIL_KERNEL_PREBUILDER_H
+
+#include <sycl/sycl.hpp>
+
+#include "singleton.h"
+
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Builds the executable kernel bundles of all kernels of the executable ahead
+ * of the tests for the `--prebuild-kernels` CLI parameter, so that just-in-time
+ * compilation runs concurrently instead of on the critical path of each test.
+ *
+ * Kernels are built for the context of sycl_object_cache and for the context a
+ * queue on the CTS device gets by default, which get_cts_object::queue() uses.
+ * Whether later submissions reuse the built programs depends on the program
+ * cache of the SYCL implementation, so the bundles are kept alive until the
+ * process exits.
+ */
+class kernel_prebuilder : public singleton<kernel_prebuilder> {
+ public:
+  /**
+   * Builds all kernels on the given number of threads, or one thread per
+   * hardware thread if zero, and prints a summary to out. Only the first call
+   * builds anything.
+   */
+  void prebuild(unsigned threads, std::ostream& out);
+
+ private:
+  std::mutex m_mutex;
+  bool m_done = false;
+#if !SYCL_CTS_COMPILING_WITH_COMPUTECPP && !SYCL_CTS_COMPILING_WITH_HIPSYCL
+  std::vector<sycl::kernel_bundle<sycl::bundle_state::executable>> m_bundles;
+#endif
+};
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_KERNEL_PREBUILDER_H
@@ -0,0 +1,106 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "kernel_profiler.h"
+
+#include "json.h"
+
+#include <iomanip>
+
+namespace sycl_cts {
+namespace util {
+
+void kernel_profiler::set_scope(const std::string& testCase,
+                                const std::string& section) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_scope = {testCase, section};
+  profile(m_scope);
+}
+
+void kernel_profiler::record(const sycl::event& event) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pending.emplace_back(m_scope, event);
+}
+
+void kernel_profiler::end_scope(const std::string& testCase,
+                                const std::string& section,
+                                double hostSeconds) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  resolve_pending();
+  profile({testCase, section}).hostNs += hostSeconds * 1e9;
+}
+
+void kernel_profiler::write(std::ostream& out) const {
+  const auto flags = out.flags();
+  out << std::fixed << std::setprecision(0);
+  for (const auto& scope : m_order) {
+    const kernel_profile& p = m_profiles.at(scope);
+    out << "[kernel-profile] {\"test-case\": " << json_string(scope.first)
+        << ", \"section\": " << json_string(scope.second)
+        << ", \"commands\": " << p.commands
+        << ", \"unprofiled-commands\": " << p.unprofiled
+        << ", \"queued-ns\": " << p.queuedNs
+        << ", \"device-ns\": " << p.deviceNs << ", \"host-ns\": " << p.hostNs
+        << "}\n";
+  }
+  out.flags(flags);
+}
+
+void kernel_profiler::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_scope = {};
+  m_pending.clear();
+  m_order.clear();
+  m_profiles.clear();
+}
+
+kernel_profile& kernel_profiler::profile(const scope_t& scope) {
+  auto it = m_profiles.find(scope);
+  if (it == m_profiles.end()) {
+    m_order.push_back(scope);
+    it = m_profiles.emplace(scope, kernel_profile{}).first;
+  }
+  return it->second;
+}
+
+void kernel_profiler::resolve_pending() {
+  using namespace sycl::info;
+  for (auto& [scope, event] : m_pending) {
+    kernel_profile& p = profile(scope);
+    try {
+      const auto submitted =
+          event.get_profiling_info<event_profiling::command_submit>();
+      const auto started =
+          event.get_profiling_info<event_profiling::command_start>();
+      const auto ended =
+          event.get_profiling_info<event_profiling::command_end>();
+      p.queuedNs += static_cast<double>(started - submitted);
+      p.deviceNs += static_cast<double>(ended - started);
+      ++p.commands;
+    } catch (const sycl::exception&) {
+      // The queue of the command was not created with profiling enabled
+      ++p.unprofiled;
+    }
+  }
+  m_pending.clear();
+}
+
+}  // namespace util
+}  // namespace sycl_cts
@@ -0,0 +1,143 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_KERNEL_PROFILER_H
+#define __SYCLCTS_UTIL_KERNEL_PROFILER_H
+
+#include "singleton.h"
+#include "trace_recorder.h"
+
+#include <sycl/sycl.hpp>
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Device and host time attributed to a test case or one of its sections.
+ * Sections run several times are accumulated.
+ */
+struct kernel_profile {
+  /** Commands with profiling information */
+  size_t commands = 0;
+  /** Commands submitted to queues without profiling enabled */
+  size_t unprofiled = 0;
+  /** Time between submission and start of the commands */
+  double queuedNs = 0;
+  /** Time between start and end of the commands */
+  double deviceNs = 0;
+  /** Wall time spent in the test case or section */
+  double hostNs = 0;
+};
+
+/**
+ * Records the device time of commands for the `--profile-kernels` CLI
+ * parameter. SYCL has no hook for all submissions, so only the events passed
+ * to record() are profiled; the CTS helpers that submit on behalf of tests do
+ * so. The host time of every test case and section is always recorded, which
+ * tells device execution apart from harness overhead.
+ */
+class kernel_profiler : public singleton<kernel_profiler> {
+ public:
+  void set_enabled(bool enabled) { m_enabled = enabled; }
+  bool enabled() const { return m_enabled; }
+
+  /**
+   * Returns the property list for a CTS queue on device with the given
+   * properties, with profiling enabled when profiling or tracing is requested
+   * and device supports it. Commands of queues without profiling are counted
+   * as unprofiled.
+   */
+  template <typename... propertiesT>
+  sycl::property_list queue_properties(const sycl::device& device,
+                                       propertiesT... properties) const {
+    if ((m_enabled || get<trace_recorder>().enabled()) &&
+        device.has(sycl::aspect::queue_profiling)) {
+      return sycl::property_list{properties...,
+                                 sycl::property::queue::enable_profiling{}};
+    }
+    return sycl::property_list{properties...};
+  }
+
+  /**
+   * Sets the test case and section the following commands are attributed to.
+   */
+  void set_scope(const std::string& testCase, const std::string& section);
+
+  /**
+   * Attributes the command of event to the current scope. Its profiling
+   * information is read once the scope ends, so this does not wait.
+   */
+  void record(const sycl::event& event);
+
+  /**
+   * Ends the given scope, adding its wall time and the device time of all
+   * commands recorded in it.
+   */
+  void end_scope(const std::string& testCase, const std::string& section,
+                 double hostSeconds);
+
+  /**
+   * Prints one `[kernel-profile]` line with a JSON object per scope, in the
+   * order the scopes first ran. run_conformance_tests.py reads these lines
+   * from the test output.
+   */
+  void write(std::ostream& out) const;
+
+  /**
+   * Drops all recorded scopes, as cts_server runs several sessions.
+   */
+  void clear();
+
+ private:
+  using scope_t = std::pair<std::string, std::string>;
+
+  kernel_profile& profile(const scope_t& scope);
+  void resolve_pending();
+
+  bool m_enabled = false;
+  std::mutex m_mutex;
+  scope_t m_scope;
+  std::vector<std::pair<scope_t, sycl::event>> m_pending;
+  std::vector<scope_t> m_order;
+  std::map<scope_t, kernel_profile> m_profiles;
+};
+
+/**
+ * Records the command of event for `--profile-kernels` and `--trace`, if
+ * enabled.
+ */
+inline void record_kernel_profile(const sycl::event& event) {
+  auto& profiler = get<kernel_profiler>();
+  if (profiler.enabled()) profiler.record(event);
+  auto& recorder = get<trace_recorder>();
+  if (recorder.enabled()) recorder.record(event);
+}
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_KERNEL_PROFILER_H
@@ -22,8 +22,8 @@
 #ifndef __SYCLCTS_UTIL_MATH_HELPER_H
 #define __SYCLCTS_UTIL_MATH_HELPER_H
 
-#include <map>
 #include <climits>
+#include <cstdint>
 
 #include <sycl/sycl.hpp>
 
@@ -35,17 +35,35 @@ namespace sycl_cts {
 /** math utility functions
  */
 
+/** Fixed-width set of vector or marray lanes whose reference result is
+ *  undefined according to the specification
+ */
+class undefined_lanes {
+ public:
+  static constexpr int max_lanes = 64;
+
+  void set(int lane) { m_mask |= uint64_t(1) << lane; }
+  bool test(int lane) const { return (m_mask >> lane) & 1; }
+  bool empty() const { return m_mask == 0; }
+
+ private:
+  uint64_t m_mask = 0;
+};
+
 template <typename returnT> struct resultRef {
   returnT res;
-  std::map<int, bool> undefined;
+  undefined_lanes undefined;
+
+  resultRef() = default;
 
   template <typename U>
-  resultRef(U res_t, std::map<int, bool> und_t)
+  resultRef(U res_t, undefined_lanes und_t)
       : res(res_t), undefined(und_t) {}
 
   template <typename U>
-  resultRef(U res_t, bool und_t)
-      : res(res_t), undefined({{0, und_t}}) {}
+  resultRef(U res_t, bool und_t) : res(res_t) {
+    if (und_t) undefined.set(0);
+  }
 
   template <typename U> resultRef(U res_t) : res(res_t) {}
 
@@ -160,14 +178,15 @@ sycl::marray<bool, N> run_rel_func_on_marray(funT fun, Args... args) {
 template <typename T, int N, typename funT, typename... Args>
 sycl_cts::resultRef<sycl::vec<T, N>>
 run_func_on_vector_result_ref(funT fun, Args... args) {
+  static_assert(N <= undefined_lanes::max_lanes, "Too many lanes");
   sycl::vec<T, N> res;
-  std::map<int, bool> undefined;
+  undefined_lanes undefined;
   for (int i = 0; i < N; i++) {
     resultRef<T> element = fun(getElement(args, i)...);
     if (element.undefined.empty())
       setElement<T, N>(res, i, element.res);
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::vec<T, N>>(res, undefined);
 }
@@ -177,14 +196,15 @@ run_func_on_vector_result_ref(funT fun, Args... args) {
 template <typename T, size_t N, typename funT, typename... Args>
 sycl_cts::resultRef<sycl::marray<T, N>> run_func_on_marray_result_ref(
     funT fun, Args... args) {
+  static_assert(N <= undefined_lanes::max_lanes, "Too many lanes");
   sycl::marray<T, N> res;
-  std::map<int, bool> undefined;
+  undefined_lanes undefined;
   for (size_t i = 0; i < N; i++) {
     resultRef<T> element = fun(getElement(args, i)...);
     if (element.undefined.empty())
       res[i] = element.res;
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::marray<T, N>>(res, undefined);
 }
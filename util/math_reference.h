@@ -363,13 +363,13 @@ sycl_cts::resultRef<sycl::vec<T, N>> clamp(sycl::vec<T, N> a, sycl::vec<T, N> b,
 template <typename T, int N>
 sycl_cts::resultRef<sycl::vec<T, N>> clamp(sycl::vec<T, N> a, T b, T c) {
   sycl::vec<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (int i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = clamp(getElement(a, i), b, c);
     if (element.undefined.empty())
       setElement<T, N>(res, i, element.res);
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::vec<T, N>>(res, undefined);
 }
@@ -385,13 +385,13 @@ sycl_cts::resultRef<sycl::marray<T, N>> clamp(sycl::marray<T, N> a,
 template <typename T, size_t N>
 sycl_cts::resultRef<sycl::marray<T, N>> clamp(sycl::marray<T, N> a, T b, T c) {
   sycl::marray<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (size_t i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = clamp(a[i], b, c);
     if (element.undefined.empty())
       res[i] = element.res;
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::marray<T, N>>(res, undefined);
 }
@@ -707,13 +707,13 @@ template <typename T, int N>
 sycl_cts::resultRef<sycl::vec<T, N>> mix(sycl::vec<T, N> a, sycl::vec<T, N> b,
                                          T c) {
   sycl::vec<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (int i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = mix(getElement(a, i), getElement(b, i), c);
     if (element.undefined.empty())
       setElement<T, N>(res, i, element.res);
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::vec<T, N>>(res, undefined);
 }
@@ -730,13 +730,13 @@ template <typename T, size_t N>
 sycl_cts::resultRef<sycl::marray<T, N>> mix(sycl::marray<T, N> a,
                                             sycl::marray<T, N> b, T c) {
   sycl::marray<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (size_t i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = mix(a[i], b[i], c);
     if (element.undefined.empty())
       res[i] = element.res;
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::marray<T, N>>(res, undefined);
 }
@@ -790,13 +790,13 @@ sycl_cts::resultRef<sycl::vec<T, N>> smoothstep(sycl::vec<T, N> a,
 template <typename T, int N>
 sycl_cts::resultRef<sycl::vec<T, N>> smoothstep(T a, T b, sycl::vec<T, N> c) {
   sycl::vec<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (int i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = smoothstep(a, b, getElement(c, i));
     if (element.undefined.empty())
       setElement<T, N>(res, i, element.res);
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::vec<T, N>>(res, undefined);
 }
@@ -813,13 +813,13 @@ template <typename T, size_t N>
 sycl_cts::resultRef<sycl::marray<T, N>> smoothstep(T a, T b,
                                                    sycl::marray<T, N> c) {
   sycl::marray<T, N> res;
-  std::map<int, bool> undefined;
+  sycl_cts::undefined_lanes undefined;
   for (size_t i = 0; i < N; i++) {
     sycl_cts::resultRef<T> element = smoothstep(a, b, c[i]);
     if (element.undefined.empty())
       res[i] = element.res;
     else
-      undefined[i] = true;
+      undefined.set(i);
   }
   return sycl_cts::resultRef<sycl::marray<T, N>>(res, undefined);
 }
@@ -0,0 +1,53 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+
+#include "math_reference_batch.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace sycl_cts {
+namespace math {
+
+void parallel_for_chunks(size_t count, size_t minChunk,
+                         const std::function<void(size_t, size_t)> &fun) {
+  const size_t hwThreads =
+      std::max<size_t>(1, std::thread::hardware_concurrency());
+  const size_t chunks =
+      std::min(hwThreads, std::max<size_t>(1, count / std::max<size_t>(
+                                                  1, minChunk)));
+  if (chunks <= 1) {
+    fun(0, count);
+    return;
+  }
+
+  const size_t chunkSize = (count + chunks - 1) / chunks;
+  std::vector<std::thread> threads;
+  threads.reserve(chunks - 1);
+  // The calling thread evaluates the first chunk itself
+  for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+    threads.emplace_back(fun, begin, std::min(count, begin + chunkSize));
+  fun(0, std::min(count, chunkSize));
+  for (auto &thread : threads) thread.join();
+}
+
+}  // namespace math
+}  // namespace sycl_cts
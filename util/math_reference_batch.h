@@ -0,0 +1,101 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+
+#ifndef __SYCLCTS_UTIL_MATH_REFERENCE_BATCH_H
+#define __SYCLCTS_UTIL_MATH_REFERENCE_BATCH_H
+
+#include "./math_helper.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace sycl_cts {
+namespace math {
+
+/**
+ * @brief Calls fun(begin, end) for contiguous chunks covering [0, count),
+ *        using up to one host thread per hardware thread
+ * @param minChunk Smallest number of elements worth a separate thread
+ */
+void parallel_for_chunks(size_t count, size_t minChunk,
+                         const std::function<void(size_t, size_t)> &fun);
+
+namespace detail {
+template <typename T>
+struct result_ref_value {
+  using type = T;
+};
+template <typename T>
+struct result_ref_value<sycl_cts::resultRef<T>> {
+  using type = T;
+};
+}  // namespace detail
+
+/** Value type of the resultRef produced by calling funT with argTs */
+template <typename funT, typename... argTs>
+using batch_result_t = typename detail::result_ref_value<
+    std::invoke_result_t<funT, const argTs &...>>::type;
+
+/** Default number of elements a host thread evaluates at least */
+constexpr size_t reference_batch_min_chunk = 1024;
+
+/**
+ * @brief Evaluates a scalar, vec or marray reference function for count
+ *        inputs on multiple host threads
+ * @param fun Reference function, e.g. a lambda calling reference::sin
+ * @param results Output span of count elements
+ * @param args Input spans of count elements each
+ *
+ * Every element is computed by the same function that is used for single
+ * checks, so batched and single results are identical.
+ */
+template <typename returnT, typename funT, typename... argTs>
+void evaluate_reference_batch(funT fun, size_t count,
+                              sycl_cts::resultRef<returnT> *results,
+                              const argTs *... args) {
+  parallel_for_chunks(count, reference_batch_min_chunk,
+                      [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i)
+                          results[i] = fun(args[i]...);
+                      });
+}
+
+/**
+ * @brief Evaluates a reference function for every set of inputs
+ * @return One resultRef per input element
+ */
+template <typename funT, typename argT, typename... argTs>
+std::vector<sycl_cts::resultRef<batch_result_t<funT, argT, argTs...>>>
+evaluate_reference_batch(funT fun, const std::vector<argT> &arg,
+                         const std::vector<argTs> &... args) {
+  std::vector<sycl_cts::resultRef<batch_result_t<funT, argT, argTs...>>>
+      results(arg.size());
+  evaluate_reference_batch(fun, arg.size(), results.data(), arg.data(),
+                           args.data()...);
+  return results;
+}
+
+}  // namespace math
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_MATH_REFERENCE_BATCH_H
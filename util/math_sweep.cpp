@@ -0,0 +1,39 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+
+#include "math_sweep.h"
+
+namespace sycl_cts {
+namespace math {
+
+sweep_rng::sweep_rng(uint32_t seed, int testCaseId)
+    // Golden ratio multiplier spreads consecutive test case ids
+    : m_data(init_genrand(seed ^ (static_cast<uint32_t>(testCaseId) *
+                                  0x9e3779b9u))) {}
+
+sweep_rng::~sweep_rng() { free_mtdata(m_data); }
+
+uint32_t sweep_rng::next32() { return genrand_int32(m_data); }
+
+uint64_t sweep_rng::next64() { return genrand_int64(m_data); }
+
+}  // namespace math
+}  // namespace sycl_cts
@@ -0,0 +1,383 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+
+#ifndef __SYCLCTS_UTIL_MATH_SWEEP_H
+#define __SYCLCTS_UTIL_MATH_SWEEP_H
+
+#include <sycl/sycl.hpp>
+
+#include "./math_helper.h"
+#include "singleton.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Settings of the randomized math builtin input sweeps, set by the
+ * `--math-seed` and `--math-samples` CLI parameters.
+ */
+class math_sweep_config : public singleton<math_sweep_config> {
+ public:
+  void set_seed(uint32_t seed) { m_seed = seed; }
+  void set_samples(size_t samples) { m_samples = samples; }
+
+  /**
+   * @return The seed all sweep inputs are derived from
+   */
+  uint32_t seed() const { return m_seed; }
+
+  /**
+   * @return The number of inputs each swept math builtin is checked with
+   */
+  size_t samples() const { return m_samples; }
+
+ private:
+  uint32_t m_seed = 0;
+  size_t m_samples = 1024;
+};
+
+}  // namespace util
+
+namespace math {
+
+/**
+ * Owns the oclmath mt19937 state used to generate the inputs of one test
+ * case, seeded from the sweep seed and the test case id so that every case
+ * gets its own reproducible stream.
+ */
+class sweep_rng {
+ public:
+  sweep_rng(uint32_t seed, int testCaseId);
+  ~sweep_rng();
+
+  sweep_rng(const sweep_rng &) = delete;
+  sweep_rng &operator=(const sweep_rng &) = delete;
+
+  uint32_t next32();
+  uint64_t next64();
+
+ private:
+  MTdata m_data;
+};
+
+/** Out of how many scalar values one is taken from the edge values */
+constexpr uint32_t sweep_edge_value_ratio = 8;
+
+/**
+ * Inputs a swept math builtin is checked with, for builtins whose results are
+ * undefined or inaccurate for most of the full range of their argument types.
+ * The generator picks the domain of each builtin.
+ */
+struct sweep_domain {
+  /** Bounds of the floating-point inputs, NaN is outside of finite bounds */
+  double min = -std::numeric_limits<double>::infinity();
+  double max = std::numeric_limits<double>::infinity();
+  /** Whether floating-point inputs are integers, so that products and
+   *  differences of them are exact */
+  bool integers = false;
+  /** Arguments whose lanes are swapped where the one at lessArg is greater
+   *  than the one at greaterArg, -1 if none */
+  int lessArg = -1;
+  int greaterArg = -1;
+
+  bool bounded() const {
+    return std::isfinite(min) || std::isfinite(max) || integers;
+  }
+
+  /** Floating-point inputs in [min, max] */
+  static sweep_domain bounded(double min, double max) {
+    sweep_domain domain;
+    domain.min = min;
+    domain.max = max;
+    return domain;
+  }
+
+  /** Integer floating-point inputs in [min, max] */
+  static sweep_domain integers_in(double min, double max) {
+    sweep_domain domain = bounded(min, max);
+    domain.integers = true;
+    return domain;
+  }
+
+  /** Inputs where no lane of argument less is greater than the same lane of
+   *  argument greater, such as the bounds of clamp */
+  static sweep_domain ordered(int less, int greater) {
+    sweep_domain domain;
+    domain.lessArg = less;
+    domain.greaterArg = greater;
+    return domain;
+  }
+};
+
+namespace detail {
+template <typename T>
+constexpr bool is_sweep_float_v =
+    std::is_floating_point_v<T> || std::is_same_v<T, sycl::half>;
+
+template <typename T>
+double to_double(T value) {
+  if constexpr (std::is_same_v<T, sycl::half>)
+    return static_cast<float>(value);
+  else
+    return value;
+}
+
+template <typename T>
+T from_double(double value) {
+  if constexpr (std::is_same_v<T, double>)
+    return value;
+  else
+    return static_cast<T>(static_cast<float>(value));
+}
+}  // namespace detail
+
+/**
+ * @return Whether value lies within the bounds of domain; values of
+ *         integral types always do
+ */
+template <typename T>
+bool in_sweep_domain(T value, const sweep_domain &domain) {
+  if constexpr (detail::is_sweep_float_v<T>) {
+    if (!domain.bounded()) return true;
+    const double x = detail::to_double(value);
+    return x >= domain.min && x <= domain.max &&
+           (!domain.integers || x == std::trunc(x));
+  } else {
+    return true;
+  }
+}
+
+/**
+ * @return Zeros, denormals, boundaries, infinities, NaN and small integers
+ *         represented by T
+ */
+template <typename T>
+std::vector<T> sweep_edge_values() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return {false, true};
+  } else if constexpr (std::is_same_v<T, sycl::half>) {
+    // Bit patterns, as std::numeric_limits is not specialized for sycl::half
+    // by every implementation
+    const uint16_t bits[] = {0x0000, 0x8000, 0x0001, 0x8001, 0x0400,
+                             0x8400, 0x7bff, 0xfbff, 0x7c00, 0xfc00,
+                             0x7e00, 0x3c00, 0xbc00, 0x3800, 0xb800};
+    std::vector<T> values;
+    for (const uint16_t b : bits) {
+      T value;
+      std::memcpy(&value, &b, sizeof(T));
+      values.push_back(value);
+    }
+    return values;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    using limits = std::numeric_limits<T>;
+    return {T(0),
+            -T(0),
+            limits::denorm_min(),
+            -limits::denorm_min(),
+            limits::min(),
+            -limits::min(),
+            limits::max(),
+            -limits::max(),
+            limits::infinity(),
+            -limits::infinity(),
+            limits::quiet_NaN(),
+            T(1),
+            T(-1),
+            T(0.5),
+            T(-0.5)};
+  } else {
+    using limits = std::numeric_limits<T>;
+    return {T(0), T(1), T(-1), T(2), limits::min(), limits::max()};
+  }
+}
+
+/**
+ * @brief Generates a scalar input: either one of the edge values or a value
+ *        made of random bits, which covers the full range of T including
+ *        denormals, infinities and NaN. Random values outside of a bounded
+ *        domain are replaced by uniformly distributed values within it.
+ * @param edgeValues Edge values within the domain, may be empty
+ */
+template <typename T>
+T sweep_scalar_value(sweep_rng &rng, const std::vector<T> &edgeValues,
+                     const sweep_domain &domain = {}) {
+  if (!edgeValues.empty() && rng.next32() % sweep_edge_value_ratio == 0)
+    return edgeValues[rng.next32() % edgeValues.size()];
+  if constexpr (std::is_same_v<T, bool>) {
+    return rng.next32() & 1;
+  } else {
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Unsupported type");
+    const uint64_t bits = rng.next64();
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    if constexpr (detail::is_sweep_float_v<T>) {
+      if (!in_sweep_domain(value, domain)) {
+        // 53 random bits give a uniform double in [0, 1)
+        const double unit = static_cast<double>(rng.next64() >> 11) * 0x1p-53;
+        double x = domain.min + unit * (domain.max - domain.min);
+        if (domain.integers) x = std::round(x);
+        value = detail::from_double<T>(x);
+      }
+    }
+    return value;
+  }
+}
+
+namespace detail {
+template <typename T>
+struct sweep_input {
+  using element_type = T;
+  static T make(sweep_rng &rng, const std::vector<T> &edgeValues,
+                const sweep_domain &domain) {
+    return sweep_scalar_value(rng, edgeValues, domain);
+  }
+};
+
+template <typename T, int N>
+struct sweep_input<sycl::vec<T, N>> {
+  using element_type = T;
+  static sycl::vec<T, N> make(sweep_rng &rng,
+                              const std::vector<T> &edgeValues,
+                              const sweep_domain &domain) {
+    sycl::vec<T, N> value;
+    for (int i = 0; i < N; i++)
+      setElement<T, N>(value, i, sweep_scalar_value(rng, edgeValues, domain));
+    return value;
+  }
+};
+
+// FIXME: hipSYCL does not support marray
+#ifndef SYCL_CTS_COMPILING_WITH_HIPSYCL
+template <typename T, size_t N>
+struct sweep_input<sycl::marray<T, N>> {
+  using element_type = T;
+  static sycl::marray<T, N> make(sweep_rng &rng,
+                                 const std::vector<T> &edgeValues,
+                                 const sweep_domain &domain) {
+    sycl::marray<T, N> value;
+    for (size_t i = 0; i < N; i++)
+      value[i] = sweep_scalar_value(rng, edgeValues, domain);
+    return value;
+  }
+};
+#endif
+
+template <typename T>
+void order_values(T &less, T &greater) {
+  if (greater < less) std::swap(less, greater);
+}
+
+template <typename T, int N>
+void order_values(sycl::vec<T, N> &less, sycl::vec<T, N> &greater) {
+  for (int i = 0; i < N; i++) {
+    T l = getElement(less, i);
+    T g = getElement(greater, i);
+    order_values(l, g);
+    setElement<T, N>(less, i, l);
+    setElement<T, N>(greater, i, g);
+  }
+}
+
+// FIXME: hipSYCL does not support marray
+#ifndef SYCL_CTS_COMPILING_WITH_HIPSYCL
+template <typename T, size_t N>
+void order_values(sycl::marray<T, N> &less, sycl::marray<T, N> &greater) {
+  for (size_t i = 0; i < N; i++) order_values(less[i], greater[i]);
+}
+#endif
+
+template <size_t Less, size_t Greater, typename tupleT>
+void order_arguments(const sweep_domain &domain, size_t count,
+                     const tupleT &inputs) {
+  auto *less = std::get<Less>(inputs);
+  auto *greater = std::get<Greater>(inputs);
+  if constexpr (std::is_same_v<decltype(less), decltype(greater)>) {
+    if (domain.lessArg != static_cast<int>(Less) ||
+        domain.greaterArg != static_cast<int>(Greater))
+      return;
+    for (size_t i = 0; i < count; i++) order_values(less[i], greater[i]);
+  }
+}
+
+template <size_t Less, typename tupleT, size_t... Greater>
+void order_arguments(const sweep_domain &domain, size_t count,
+                     const tupleT &inputs, std::index_sequence<Greater...>) {
+  (order_arguments<Less, Greater>(domain, count, inputs), ...);
+}
+
+template <typename tupleT, size_t... Less>
+void order_all_arguments(const sweep_domain &domain, size_t count,
+                         const tupleT &inputs,
+                         std::index_sequence<Less...> indices) {
+  (order_arguments<Less>(domain, count, inputs, indices), ...);
+}
+}  // namespace detail
+
+/**
+ * @brief Generates the inputs of one argument of a swept math builtin
+ * @tparam T Scalar, vec or marray argument type
+ * @return Array of count inputs; not a std::vector, as std::vector<bool> does
+ *         not provide contiguous storage
+ */
+template <typename T>
+std::unique_ptr<T[]> make_sweep_inputs(sweep_rng &rng, size_t count,
+                                       const sweep_domain &domain = {}) {
+  using input = detail::sweep_input<T>;
+  auto edgeValues = sweep_edge_values<typename input::element_type>();
+  edgeValues.erase(std::remove_if(edgeValues.begin(), edgeValues.end(),
+                                  [&](const auto &value) {
+                                    return !in_sweep_domain(value, domain);
+                                  }),
+                   edgeValues.end());
+  std::unique_ptr<T[]> inputs(new T[count]);
+  for (size_t i = 0; i < count; i++)
+    inputs[i] = input::make(rng, edgeValues, domain);
+  return inputs;
+}
+
+/**
+ * @brief Swaps the lanes of the arguments selected by domain.lessArg and
+ *        domain.greaterArg where the first one is greater
+ * @param inputs Inputs of each argument, as made by make_sweep_inputs()
+ */
+template <typename... argTs>
+void order_sweep_inputs(const sweep_domain &domain, size_t count,
+                        argTs *... inputs) {
+  if (domain.lessArg < 0) return;
+  detail::order_all_arguments(domain, count, std::make_tuple(inputs...),
+                              std::index_sequence_for<argTs...>{});
+}
+
+}  // namespace math
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_MATH_SWEEP_H
@@ -0,0 +1,639 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "parallel_session.h"
+
+#include "trace_recorder.h"
+#include "xml_reader.h"
+
+#include <catch2/catch_assertion_info.hpp>
+#include <catch2/catch_assertion_result.hpp>
+#include <catch2/catch_config.hpp>
+#include <catch2/catch_section_info.hpp>
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/catch_totals.hpp>
+#include <catch2/interfaces/catch_interfaces_registry_hub.hpp>
+#include <catch2/interfaces/catch_interfaces_reporter.hpp>
+#include <catch2/interfaces/catch_interfaces_reporter_registry.hpp>
+#include <catch2/internal/catch_istream.hpp>
+#include <catch2/internal/catch_message_info.hpp>
+#include <catch2/internal/catch_test_case_registry_impl.hpp>
+#include <catch2/reporters/catch_reporter_multi.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace sycl_cts {
+namespace util {
+
+namespace {
+
+/** Escapes characters with a special meaning in Catch2 test specs, so that
+ *  a test case name only matches itself
+ */
+std::string escape_test_name(const std::string& name) {
+  std::string escaped;
+  for (const char c : name) {
+    if (c == '\\' || c == '[' || c == ']' || c == ',' || c == '"' ||
+        c == '~' || c == '*') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+std::string quote_argument(const std::string& arg) {
+#ifdef _WIN32
+  std::string quoted = "\"";
+  for (const char c : arg) {
+    if (c == '"') quoted += '\\';
+    quoted += c;
+  }
+  return quoted + "\"";
+#else
+  std::string quoted = "'";
+  for (const char c : arg) {
+    if (c == '\'')
+      quoted += "'\\''";
+    else
+      quoted += c;
+  }
+  return quoted + "'";
+#endif
+}
+
+int run_command(const std::string& command) {
+#ifdef _WIN32
+  // cmd.exe strips the outermost quotes of the command line
+  return std::system(("\"" + command + "\"").c_str());
+#else
+  const int status = std::system(command.c_str());
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 255;
+#endif
+}
+
+bool is_serial(const Catch::TestCaseInfo& info) {
+  const std::string tag{serial_test_tag};
+  const auto tagName = tag.substr(1, tag.size() - 2);
+  return std::any_of(info.tags.begin(), info.tags.end(),
+                     [&](const Catch::Tag& t) { return t.original == tagName; });
+}
+
+/**
+ * Options of the parent that are not passed on to the workers, as the
+ * workers are run with options of their own instead. Each option takes a
+ * value.
+ */
+const std::vector<std::string> parent_only_options = {
+    "--jobs", "--trace", "-r", "--reporter", "-o", "--out", "-d",
+    "--durations"};
+
+/** Returns whether arg is one of the parent_only_options, and sets
+ *  hasValue if the value is in the same argument
+ */
+bool is_parent_only_option(const std::string& arg, bool& hasValue) {
+  for (const auto& option : parent_only_options) {
+    if (arg == option) {
+      hasValue = false;
+      return true;
+    }
+    // Catch2 accepts both `--option=value` and `--option:value`
+    if (arg.size() > option.size() &&
+        arg.compare(0, option.size(), option) == 0 &&
+        (arg[option.size()] == '=' || arg[option.size()] == ':')) {
+      hasValue = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64_t to_count(const std::string& value) {
+  return std::strtoull(value.c_str(), nullptr, 10);
+}
+
+double to_double(const std::string& value) {
+  return std::strtod(value.c_str(), nullptr);
+}
+
+Catch::Counts read_counts(const xml_element& element,
+                          const std::string& skippedAttribute) {
+  Catch::Counts counts;
+  counts.passed = to_count(element.attribute("successes"));
+  counts.failed = to_count(element.attribute("failures"));
+  counts.failedButOk = to_count(element.attribute("expectedFailures"));
+  // Sections only record whether anything in them was skipped
+  const auto skipped = element.attribute(skippedAttribute);
+  counts.skipped = skipped == "true" ? 1 : to_count(skipped);
+  return counts;
+}
+
+template <typename T>
+struct listener_argument;
+template <typename C, typename A>
+struct listener_argument<void (C::*)(A)> {
+  using type = std::remove_cv_t<std::remove_reference_t<A>>;
+};
+
+// The benchmark types are templates in some Catch2 v3 releases and plain
+// structs in others, so take them from the listener interface itself
+using benchmark_info_t = listener_argument<
+    decltype(&Catch::IEventListener::benchmarkStarting)>::type;
+using benchmark_stats_t =
+    listener_argument<decltype(&Catch::IEventListener::benchmarkEnded)>::type;
+
+template <typename EstimateT>
+void read_estimate(const xml_element* element, EstimateT& estimate) {
+  if (element == nullptr) return;
+  using duration_t = decltype(estimate.point);
+  const auto read_ns = [&](const char* attributeName) {
+    return std::chrono::duration_cast<duration_t>(
+        std::chrono::duration<double, std::nano>(
+            to_double(element->attribute(attributeName))));
+  };
+  estimate.point = read_ns("value");
+  estimate.lower_bound = read_ns("lowerBound");
+  estimate.upper_bound = read_ns("upperBound");
+  estimate.confidence_interval = to_double(element->attribute("ci"));
+}
+
+/**
+ * Reports the results written by the XML reporter of a worker to the
+ * reporters of this process, as if the test cases had run here.
+ *
+ * The XML reporter only writes the assertions that failed, unless `--success`
+ * is used, so the counts are taken from its summaries rather than from the
+ * assertions that are reported again.
+ */
+class result_replayer {
+ public:
+  explicit result_replayer(Catch::IEventListener& reporter)
+      : m_reporter(reporter) {}
+
+  /**
+   * Reports the test case from its element in the results of a worker
+   * @param element Element of the test case, nullptr if the worker did not
+   *                report it
+   * @param missingReason Failure reported if the test case did not finish
+   * @return Totals of the test case
+   */
+  Catch::Totals replay_test_case(const Catch::TestCaseInfo& info,
+                                 const xml_element* element,
+                                 const std::string& missingReason) {
+    m_testCase = &info;
+    m_infoMessages.clear();
+    m_totals = Catch::Totals{};
+
+    m_reporter.testCaseStarting(info);
+    m_reporter.testCasePartialStarting(info, 0);
+    const Catch::SectionInfo section(info.lineInfo, info.name);
+    m_reporter.sectionStarting(section);
+
+    Catch::Counts counts;
+    if (element != nullptr) counts = replay_children(*element);
+    const auto* result =
+        element != nullptr ? element->child("OverallResult") : nullptr;
+    const bool finished = result != nullptr && element->complete;
+    if (!finished) {
+      replay_assertion(Catch::ResultWas::FatalErrorCondition, info.lineInfo,
+                       "", "", "", missingReason, counts);
+    }
+    const double duration =
+        result != nullptr
+            ? to_double(result->attribute("durationInSeconds", "0"))
+            : 0.0;
+    m_reporter.sectionEnded(Catch::SectionStats(Catch::SectionInfo(section),
+                                                counts, duration, false));
+
+    Catch::Totals totals;
+    totals.assertions = counts;
+    if (!finished || result->attribute("success") != "true") {
+      totals.testCases.failed = 1;
+    } else if (to_count(result->attribute("skips")) > 0) {
+      totals.testCases.skipped = 1;
+    } else {
+      totals.testCases.passed = 1;
+    }
+
+    std::string stdOut, stdErr;
+    if (result != nullptr) {
+      if (const auto* out = result->child("StdOut")) stdOut = out->text + '\n';
+      if (const auto* err = result->child("StdErr")) stdErr = err->text + '\n';
+    }
+    // The worker captured the output for its XML reporter, print it again if
+    // the reporters here expect it on the console
+    if (!m_reporter.getPreferences().shouldRedirectStdOut) {
+      std::cout << stdOut;
+      std::cerr << stdErr;
+    }
+    m_reporter.testCasePartialEnded(
+        Catch::TestCaseStats(info, totals, std::string(stdOut),
+                             std::string(stdErr), false),
+        0);
+    m_reporter.testCaseEnded(Catch::TestCaseStats(
+        info, totals, std::move(stdOut), std::move(stdErr), false));
+    return totals;
+  }
+
+ private:
+  /** Keeps a string alive for the Catch2 types that only refer to it */
+  const std::string& keep(std::string value) {
+    return m_strings.emplace_back(std::move(value));
+  }
+
+  Catch::SourceLineInfo line_info(const xml_element& element) {
+    const auto& file = element.attribute("filename");
+    if (file.empty()) return m_testCase->lineInfo;
+    return Catch::SourceLineInfo(keep(file).c_str(),
+                                 to_count(element.attribute("line")));
+  }
+
+  /** Reports the children of a test case or section
+   *  @return Counts of the assertions in the children */
+  Catch::Counts replay_children(const xml_element& parent) {
+    Catch::Counts counts;
+    for (const auto& child : parent.children) {
+      const auto& name = child.name;
+      if (name == "Section") {
+        counts += replay_section(child);
+      } else if (name == "Expression") {
+        const auto* original = child.child("Original");
+        const auto* expanded = child.child("Expanded");
+        // An exception thrown while evaluating the expression is nested in it
+        const auto* exception = child.child("Exception");
+        const auto* fatal = child.child("FatalErrorCondition");
+        auto type = child.attribute("success") == "true"
+                        ? Catch::ResultWas::Ok
+                        : Catch::ResultWas::ExpressionFailed;
+        std::string message;
+        if (exception != nullptr) {
+          type = Catch::ResultWas::ThrewException;
+          message = exception->text;
+        } else if (fatal != nullptr) {
+          type = Catch::ResultWas::FatalErrorCondition;
+          message = fatal->text;
+        }
+        replay_assertion(type, line_info(child), child.attribute("type"),
+                         original != nullptr ? original->text : "",
+                         expanded != nullptr ? expanded->text : "", message,
+                         counts);
+      } else if (name == "Exception") {
+        replay_assertion(Catch::ResultWas::ThrewException, line_info(child),
+                         "", "", "", child.text, counts);
+      } else if (name == "FatalErrorCondition") {
+        replay_assertion(Catch::ResultWas::FatalErrorCondition,
+                         line_info(child), "", "", "", child.text, counts);
+      } else if (name == "Failure") {
+        replay_assertion(Catch::ResultWas::ExplicitFailure, line_info(child),
+                         "FAIL", "", "", child.text, counts);
+      } else if (name == "Skip") {
+        replay_assertion(Catch::ResultWas::ExplicitSkip, line_info(child),
+                         "SKIP", "", "", child.text, counts);
+      } else if (name == "Warning") {
+        replay_assertion(Catch::ResultWas::Warning, line_info(child), "WARN",
+                         "", "", child.text, counts);
+      } else if (name == "Info") {
+        // Messages are written before the assertion they belong to
+        Catch::MessageInfo message("INFO", line_info(child),
+                                   Catch::ResultWas::Info);
+        message.message = child.text;
+        m_infoMessages.push_back(std::move(message));
+      } else if (name == "BenchmarkResults") {
+        replay_benchmark(child);
+      }
+    }
+    return counts;
+  }
+
+  Catch::Counts replay_section(const xml_element& element) {
+    const Catch::SectionInfo section(line_info(element),
+                                     element.attribute("name"));
+    m_reporter.sectionStarting(section);
+    auto counts = replay_children(element);
+    double duration = 0.0;
+    if (const auto* results = element.child("OverallResults")) {
+      counts = read_counts(*results, "skipped");
+      duration = to_double(results->attribute("durationInSeconds", "0"));
+    }
+    m_reporter.sectionEnded(Catch::SectionStats(Catch::SectionInfo(section),
+                                                counts, duration, false));
+    return counts;
+  }
+
+  void replay_assertion(Catch::ResultWas::OfType type,
+                        const Catch::SourceLineInfo& lineInfo,
+                        const std::string& macroName,
+                        const std::string& expression,
+                        const std::string& expanded,
+                        const std::string& message, Catch::Counts& counts) {
+    const Catch::AssertionInfo info{keep(macroName), lineInfo,
+                                    keep(expression),
+                                    Catch::ResultDisposition::Normal};
+    Catch::AssertionResultData data(type, Catch::LazyExpression(false));
+    data.reconstructedExpression = expanded;
+    data.message = message;
+    const Catch::AssertionResult result(info, std::move(data));
+
+    Catch::Counts delta;
+    if (type == Catch::ResultWas::Ok) {
+      delta.passed = 1;
+    } else if (type == Catch::ResultWas::ExplicitSkip) {
+      delta.skipped = 1;
+    } else if (type != Catch::ResultWas::Warning &&
+               type != Catch::ResultWas::Info) {
+      delta.failed = 1;
+    }
+    counts += delta;
+    m_totals.assertions += delta;
+
+    m_reporter.assertionEnded(
+        Catch::AssertionStats(result, m_infoMessages, m_totals));
+    m_infoMessages.clear();
+  }
+
+  void replay_benchmark(const xml_element& element) {
+    benchmark_info_t info{};
+    info.name = element.attribute("name");
+    info.estimatedDuration = to_double(element.attribute("estimatedDuration"));
+    info.iterations = static_cast<decltype(info.iterations)>(
+        to_count(element.attribute("iterations")));
+    info.samples = static_cast<decltype(info.samples)>(
+        to_count(element.attribute("samples")));
+    info.resamples = static_cast<decltype(info.resamples)>(
+        to_count(element.attribute("resamples")));
+    info.clockResolution = to_double(element.attribute("clockResolution"));
+
+    m_reporter.benchmarkPreparing(keep(info.name));
+    if (const auto* failed = element.child("failed")) {
+      m_reporter.benchmarkFailed(keep(failed->attribute("message")));
+      return;
+    }
+    m_reporter.benchmarkStarting(info);
+
+    // The XML reporter does not write the individual samples
+    benchmark_stats_t stats{};
+    stats.info = info;
+    read_estimate(element.child("mean"), stats.mean);
+    read_estimate(element.child("standardDeviation"), stats.standardDeviation);
+    if (const auto* outliers = element.child("outliers")) {
+      using count_t = decltype(stats.outliers.low_mild);
+      stats.outlierVariance = to_double(outliers->attribute("variance"));
+      stats.outliers.samples_seen =
+          static_cast<decltype(stats.outliers.samples_seen)>(info.samples);
+      stats.outliers.low_mild =
+          static_cast<count_t>(to_count(outliers->attribute("lowMild")));
+      stats.outliers.low_severe =
+          static_cast<count_t>(to_count(outliers->attribute("lowSevere")));
+      stats.outliers.high_mild =
+          static_cast<count_t>(to_count(outliers->attribute("highMild")));
+      stats.outliers.high_severe =
+          static_cast<count_t>(to_count(outliers->attribute("highSevere")));
+    }
+    m_reporter.benchmarkEnded(stats);
+  }
+
+  Catch::IEventListener& m_reporter;
+  const Catch::TestCaseInfo* m_testCase = nullptr;
+  std::vector<Catch::MessageInfo> m_infoMessages;
+  Catch::Totals m_totals;
+  std::deque<std::string> m_strings;
+};
+
+/** Creates the reporters selected on the command line, without the
+ *  listeners, which already ran in the workers */
+Catch::IEventListenerPtr make_reporter(const Catch::Config& config) {
+  auto reporter = Catch::Detail::make_unique<Catch::MultiReporter>(&config);
+  for (const auto& spec : config.getProcessedReporterSpecs()) {
+    reporter->addReporter(
+        Catch::getRegistryHub().getReporterRegistry().create(
+            spec.name,
+            Catch::ReporterConfig(&config,
+                                  Catch::makeStream(spec.outputFilename),
+                                  spec.colourMode, spec.customOptions)));
+  }
+  return reporter;
+}
+
+std::string read_file(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+struct worker {
+  std::vector<std::string> testNames;
+  std::filesystem::path testsFile;
+  std::filesystem::path resultsFile;
+  std::filesystem::path traceFile;
+  int exitCode = 0;
+  xml_element results;
+};
+
+}  // namespace
+
+int run_parallel_session(Catch::Session& session, int argc, char** argv,
+                         int jobs) {
+  auto& config = session.config();
+  const auto testCases = Catch::filterTests(
+      Catch::getAllTestCasesSorted(config), config.testSpec(), config);
+
+  std::vector<worker> workers(jobs);
+  worker serialWorker;
+  size_t next = 0;
+  for (const auto& testCase : testCases) {
+    const auto& info = testCase.getTestCaseInfo();
+    if (is_serial(info)) {
+      serialWorker.testNames.push_back(info.name);
+    } else {
+      workers[next++ % workers.size()].testNames.push_back(info.name);
+    }
+  }
+  workers.erase(std::remove_if(workers.begin(), workers.end(),
+                               [](const worker& w) {
+                                 return w.testNames.empty();
+                               }),
+                workers.end());
+
+  // Pass on the command line, except for the options replaced below: each
+  // worker writes its results as XML and its own trace, which are merged
+  // once all workers are done
+  std::string baseCommand = quote_argument(argv[0]);
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    bool hasValue = false;
+    if (is_parent_only_option(arg, hasValue)) {
+      if (!hasValue) ++i;
+      continue;
+    }
+    baseCommand += " " + quote_argument(arg);
+  }
+  baseCommand += " --reporter xml --durations yes";
+
+  const auto tmpDir = std::filesystem::temp_directory_path();
+  const auto runId = std::to_string(std::random_device{}());
+  auto& recorder = get<trace_recorder>();
+  auto launch = [&](worker& w, size_t index) {
+    const auto prefix = "sycl_cts_" + runId + "_" + std::to_string(index);
+    w.testsFile = tmpDir / (prefix + ".tests");
+    w.resultsFile = tmpDir / (prefix + ".xml");
+    std::string traceArgument;
+    if (recorder.enabled()) {
+      w.traceFile = tmpDir / (prefix + ".trace.json");
+      traceArgument = " --trace " + quote_argument(w.traceFile.string());
+    }
+    {
+      std::ofstream testsFile(w.testsFile);
+      for (const auto& name : w.testNames) {
+        testsFile << escape_test_name(name) << '\n';
+      }
+    }
+    w.exitCode = run_command(baseCommand + " --worker-tests " +
+                             quote_argument(w.testsFile.string()) +
+                             " --out " +
+                             quote_argument(w.resultsFile.string()) +
+                             traceArgument);
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < workers.size(); ++i) {
+    threads.emplace_back(launch, std::ref(workers[i]), i);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  if (!serialWorker.testNames.empty()) {
+    launch(serialWorker, workers.size());
+    workers.push_back(std::move(serialWorker));
+  }
+
+  std::map<std::string, const worker*> workerOfTest;
+  for (size_t i = 0; i < workers.size(); ++i) {
+    auto& w = workers[i];
+    w.results = read_xml(read_file(w.resultsFile));
+    for (const auto& name : w.testNames) {
+      workerOfTest[name] = &w;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(w.testsFile, ec);
+    std::filesystem::remove(w.resultsFile, ec);
+    if (recorder.enabled()) {
+      recorder.append_worker_trace(w.traceFile.string(),
+                                   static_cast<int>(i) + 1);
+      std::filesystem::remove(w.traceFile, ec);
+    }
+  }
+  if (recorder.enabled()) recorder.write();
+
+  // Report all test cases once, in the order they would have run in a single
+  // process, with the combined totals of the workers
+  auto reporter = make_reporter(config);
+  result_replayer replayer(*reporter);
+  const Catch::TestRunInfo runInfo(config.name());
+  reporter->testRunStarting(runInfo);
+  std::map<const worker*, Catch::Totals> replayedTotals;
+  std::map<const worker*, bool> allReported;
+  for (const auto& testCase : testCases) {
+    const auto& info = testCase.getTestCaseInfo();
+    const auto* w = workerOfTest.at(info.name);
+    const xml_element* element = nullptr;
+    for (const auto& child : w->results.children) {
+      if (child.name == "TestCase" && child.attribute("name") == info.name) {
+        element = &child;
+        break;
+      }
+    }
+    const auto totals = replayer.replay_test_case(
+        info, element,
+        "The worker process running this test case exited with code " +
+            std::to_string(w->exitCode) + " before reporting its result");
+    replayedTotals[w] += totals;
+    allReported.emplace(w, true);
+    if (element == nullptr || !element->complete) allReported[w] = false;
+  }
+
+  // The summaries of the workers also count the passed assertions that were
+  // not written as XML, use them for the workers that finished
+  Catch::Totals totals;
+  for (const auto& w : workers) {
+    const auto* assertions = w.results.child("OverallResults");
+    const auto* cases = w.results.child("OverallResultsCases");
+    if (allReported[&w] && assertions != nullptr && cases != nullptr) {
+      totals.assertions += read_counts(*assertions, "skips");
+      totals.testCases += read_counts(*cases, "skips");
+    } else {
+      totals += replayedTotals[&w];
+    }
+  }
+  reporter->testRunEnded(Catch::TestRunStats(runInfo, totals, false));
+
+  // Same exit codes as Catch::Session::run()
+  const auto& cases = totals.testCases;
+  if (cases.total() == 0 && !config.zeroTestsCountAsSuccess()) return 2;
+  if (cases.total() > 0 && cases.total() == cases.skipped &&
+      !config.zeroTestsCountAsSuccess()) {
+    return 4;
+  }
+  return static_cast<int>(std::min<uint64_t>(totals.assertions.failed, 255));
+}
+
+void apply_worker_tests(Catch::Session& session,
+                        const std::string& workerTestsFile) {
+  std::ifstream testsFile(workerTestsFile);
+  std::vector<std::string> testNames;
+  for (std::string line; std::getline(testsFile, line);) {
+    if (!line.empty()) testNames.push_back(line);
+  }
+
+  auto configData = session.configData();
+  configData.testsOrTags = testNames;
+  session.useConfigData(configData);
+}
+
+void select_tests(Catch::Session& session,
+                  const std::vector<std::string>& testNames) {
+  auto configData = session.configData();
+  configData.testsOrTags.clear();
+  for (const auto& name : testNames) {
+    configData.testsOrTags.push_back(escape_test_name(name));
+  }
+  session.useConfigData(configData);
+}
+
+}  // namespace util
+}  // namespace sycl_cts
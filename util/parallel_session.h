@@ -0,0 +1,76 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_PARALLEL_SESSION_H
+#define __SYCLCTS_UTIL_PARALLEL_SESSION_H
+
+#include <catch2/catch_session.hpp>
+
+#include <string>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Test cases carrying this tag are never run concurrently with other test
+ * cases when `--jobs` is used.
+ */
+inline constexpr const char* serial_test_tag = "[serial]";
+
+/**
+ * Runs the test cases selected by the session on `jobs` worker processes.
+ *
+ * Catch2 is not thread-safe, so every worker is a separate invocation of this
+ * executable that receives its share of the test cases through a file passed
+ * with the hidden `--worker-tests` option. Each worker thereby creates its own
+ * queue on the selected device. Test cases tagged with serial_test_tag run in
+ * a final worker after all others have finished. The workers write their
+ * results with the XML reporter to temporary files. Once all of them are done,
+ * the results are reported again through the reporters selected on the
+ * command line, in the order the test cases would have run in a single
+ * process and with one summary for the whole run.
+ *
+ * @param argv Command line of this process; the `--jobs`, `--trace`,
+ *             `--reporter`, `--out` and `--durations` options are replaced
+ *             before it is passed on to the workers
+ * @return Exit code of the overall run, as Catch::Session::run() would
+ *         return it
+ */
+int run_parallel_session(Catch::Session& session, int argc, char** argv,
+                         int jobs);
+
+/**
+ * Restricts the session to the test cases listed in a file written by
+ * run_parallel_session().
+ */
+void apply_worker_tests(Catch::Session& session,
+                        const std::string& workerTestsFile);
+
+/**
+ * Restricts the session to the test cases with the given names.
+ */
+void select_tests(Catch::Session& session,
+                  const std::vector<std::string>& testNames);
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_PARALLEL_SESSION_H
@@ -0,0 +1,65 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "sycl_object_cache.h"
+
+#include "../tests/common/cts_async_handler.h"
+#include "device_manager.h"
+#include "kernel_profiler.h"
+
+namespace sycl_cts {
+namespace util {
+
+void sycl_object_cache::init() {
+  std::call_once(m_init_flag, [this] {
+    m_device = get<device_manager>().get_device();
+    m_context = sycl::context(*m_device, cts_async_handler{});
+    const auto& profiler = get<kernel_profiler>();
+    m_queue = sycl::queue(*m_context, *m_device, cts_async_handler{},
+                          profiler.queue_properties(*m_device));
+    m_in_order_queue = sycl::queue(
+        *m_context, *m_device, cts_async_handler{},
+        profiler.queue_properties(*m_device,
+                                  sycl::property::queue::in_order{}));
+  });
+}
+
+const sycl::device& sycl_object_cache::device() {
+  init();
+  return *m_device;
+}
+
+const sycl::context& sycl_object_cache::context() {
+  init();
+  return *m_context;
+}
+
+sycl::queue& sycl_object_cache::queue() {
+  init();
+  return *m_queue;
+}
+
+sycl::queue& sycl_object_cache::in_order_queue() {
+  init();
+  return *m_in_order_queue;
+}
+
+}  // namespace util
+}  // namespace sycl_cts
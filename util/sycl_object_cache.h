@@ -0,0 +1,78 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_SYCL_OBJECT_CACHE_H
+#define __SYCLCTS_UTIL_SYCL_OBJECT_CACHE_H
+
+#include <sycl/sycl.hpp>
+
+#include "singleton.h"
+
+#include <mutex>
+#include <optional>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Process-wide storage for the SYCL objects most tests run on: the CTS device,
+ * a default context for it and queues sharing that context.
+ *
+ * All objects are created on first use and live until the process exits, so
+ * that every translation unit linked into a test executable reuses the same
+ * context instead of creating its own. Tests that require a distinct queue
+ * should use get_cts_object::queue() instead.
+ */
+class sycl_object_cache : public singleton<sycl_object_cache> {
+ public:
+  /**
+   * @return The device selected for this CTS run
+   */
+  const sycl::device& device();
+
+  /**
+   * @return The context shared by all cached queues
+   */
+  const sycl::context& context();
+
+  /**
+   * @return Out-of-order queue using the CTS async handler
+   */
+  sycl::queue& queue();
+
+  /**
+   * @return In-order queue using the CTS async handler
+   */
+  sycl::queue& in_order_queue();
+
+ private:
+  void init();
+
+  std::once_flag m_init_flag;
+  std::optional<sycl::device> m_device;
+  std::optional<sycl::context> m_context;
+  std::optional<sycl::queue> m_queue;
+  std::optional<sycl::queue> m_in_order_queue;
+};
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_SYCL_OBJECT_CACHE_H
@@ -0,0 +1,175 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "trace_recorder.h"
+
+#include "json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace sycl_cts {
+namespace util {
+
+namespace {
+
+std::string trace_event(trace_recorder::track tid, const char* phase,
+                        const char* category, const std::string& name,
+                        double startUs, double durationUs) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << "{\"pid\":0,\"tid\":" << static_cast<int>(tid) << ",\"ph\":\""
+      << phase << "\",\"cat\":\"" << category
+      << "\",\"name\":" << json_string(name) << ",\"ts\":" << startUs;
+  if (phase[0] == 'X') {
+    out << ",\"dur\":" << std::max(durationUs, 0.0);
+  } else {
+    out << ",\"s\":\"t\"";
+  }
+  out << '}';
+  return out.str();
+}
+
+std::string name_event(const char* kind, int pid, int tid,
+                       const std::string& name) {
+  return "{\"pid\":" + std::to_string(pid) + ",\"tid\":" +
+         std::to_string(tid) + ",\"ph\":\"M\",\"name\":\"" + kind +
+         "\",\"args\":{\"name\":" + json_string(name) + "}}";
+}
+
+// Events of the process itself, which worker traces are rebased from
+constexpr char pid_prefix[] = "{\"pid\":0,";
+
+}  // namespace
+
+double trace_recorder::now() {
+  using namespace std::chrono;
+  return duration<double, std::micro>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void trace_recorder::set_label(const std::string& label) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_label = label;
+}
+
+void trace_recorder::complete(const std::string& name, const char* category,
+                              double startUs) {
+  add_event(trace_event(track::host, "X", category, name, startUs,
+                        now() - startUs));
+}
+
+void trace_recorder::record(const sycl::event& event) {
+  command c;
+  c.recordedNs = now() * 1e3;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  c.label = m_label;
+  m_pending.emplace_back(std::move(c), event);
+}
+
+void trace_recorder::flush() {
+  using namespace sycl::info;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& [c, event] : m_pending) {
+    try {
+      c.submitNs = static_cast<double>(
+          event.get_profiling_info<event_profiling::command_submit>());
+      c.startNs = static_cast<double>(
+          event.get_profiling_info<event_profiling::command_start>());
+      c.endNs = static_cast<double>(
+          event.get_profiling_info<event_profiling::command_end>());
+      c.profiled = true;
+    } catch (const sycl::exception&) {
+      // The queue of the command was not created with profiling enabled
+    }
+    m_commands.push_back(std::move(c));
+  }
+  m_pending.clear();
+}
+
+void trace_recorder::append_worker_trace(const std::string& file,
+                                         int worker) {
+  std::ifstream in(file);
+  const std::string prefix = "{\"pid\":" + std::to_string(worker) + ",";
+  add_event(name_event("process_name", worker, 0,
+                       "worker " + std::to_string(worker)));
+  for (std::string line; std::getline(in, line);) {
+    if (line.rfind(pid_prefix, 0) != 0) continue;
+    if (line.back() == ',') line.pop_back();
+    add_event(prefix + line.substr(sizeof(pid_prefix) - 1));
+  }
+}
+
+void trace_recorder::write() {
+  flush();
+
+  // Device timestamps are on the device clock. A command is recorded after
+  // its submission, so the smallest difference between the two bounds the
+  // offset to the host clock the closest.
+  double offsetNs = std::numeric_limits<double>::max();
+  for (const auto& c : m_commands) {
+    if (c.profiled) offsetNs = std::min(offsetNs, c.recordedNs - c.submitNs);
+  }
+  for (const auto& c : m_commands) {
+    if (!c.profiled) {
+      add_event(trace_event(track::queue, "i", "submission", c.label,
+                            c.recordedNs / 1e3, 0));
+      continue;
+    }
+    add_event(trace_event(track::queue, "X", "submission", c.label,
+                          (c.submitNs + offsetNs) / 1e3,
+                          (c.startNs - c.submitNs) / 1e3));
+    add_event(trace_event(track::device, "X", "kernel", c.label,
+                          (c.startNs + offsetNs) / 1e3,
+                          (c.endNs - c.startNs) / 1e3));
+  }
+  m_commands.clear();
+  add_event(name_event("thread_name", 0, track::host, "host"));
+  add_event(name_event("thread_name", 0, track::queue, "queue"));
+  add_event(name_event("thread_name", 0, track::device, "device"));
+
+  std::ofstream out(m_outputFile);
+  out << "{\"traceEvents\":[\n";
+  for (size_t i = 0; i < m_events.size(); ++i) {
+    out << m_events[i] << (i + 1 < m_events.size() ? ",\n" : "\n");
+  }
+  out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void trace_recorder::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_label.clear();
+  m_pending.clear();
+  m_commands.clear();
+  m_events.clear();
+}
+
+void trace_recorder::add_event(std::string event) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events.push_back(std::move(event));
+}
+
+}  // namespace util
+}  // namespace sycl_cts
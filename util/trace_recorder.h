@@ -0,0 +1,162 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_TRACE_RECORDER_H
+#define __SYCLCTS_UTIL_TRACE_RECORDER_H
+
+#include "singleton.h"
+
+#include <sycl/sycl.hpp>
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Records a timeline of the run for the `--trace` CLI parameter and writes it
+ * in the Chrome trace event format, which chrome://tracing and Perfetto open.
+ * Test cases, sections and host waits are recorded on the host track. The
+ * commands passed to record() are placed on the queue track from submission
+ * to start and on the device track from start to end.
+ */
+class trace_recorder : public singleton<trace_recorder> {
+ public:
+  enum track : int { host = 0, queue = 1, device = 2 };
+
+  /**
+   * Sets the file the trace is written to, an empty name disables tracing.
+   */
+  void set_output_file(const std::string& file) { m_outputFile = file; }
+  const std::string& output_file() const { return m_outputFile; }
+  bool enabled() const { return !m_outputFile.empty(); }
+
+  /** Microseconds on the steady clock, which all worker processes share */
+  static double now();
+
+  /**
+   * Sets the name of the commands recorded from now on, usually the running
+   * test case and section.
+   */
+  void set_label(const std::string& label);
+
+  /**
+   * Records a span of the host track from startUs to now.
+   */
+  void complete(const std::string& name, const char* category,
+                double startUs);
+
+  /**
+   * Records the command of event. Its profiling information is read by
+   * flush(), so this does not wait.
+   */
+  void record(const sycl::event& event);
+
+  /**
+   * Reads the profiling information of the commands recorded so far.
+   */
+  void flush();
+
+  /**
+   * Adds the events of the trace a `--jobs` worker wrote to file, shown as
+   * process worker in the trace.
+   */
+  void append_worker_trace(const std::string& file, int worker);
+
+  /**
+   * Writes the trace to the output file.
+   */
+  void write();
+
+  /**
+   * Drops all recorded events, as cts_server runs several sessions.
+   */
+  void clear();
+
+ private:
+  struct command {
+    std::string label;
+    double recordedNs = 0;
+    bool profiled = false;
+    double submitNs = 0;
+    double startNs = 0;
+    double endNs = 0;
+  };
+
+  void add_event(std::string event);
+
+  std::string m_outputFile;
+  std::mutex m_mutex;
+  std::string m_label;
+  std::vector<std::pair<command, sycl::event>> m_pending;
+  std::vector<command> m_commands;
+  std::vector<std::string> m_events;
+};
+
+/**
+ * Records the lifetime of the span as a span of the `--trace` host track,
+ * if tracing is enabled.
+ */
+class trace_span {
+ public:
+  trace_span(std::string name, const char* category)
+      : m_name(std::move(name)),
+        m_category(category),
+        m_start(get<trace_recorder>().enabled() ? trace_recorder::now() : 0) {}
+  trace_span(const trace_span&) = delete;
+  trace_span& operator=(const trace_span&) = delete;
+  ~trace_span() {
+    auto& recorder = get<trace_recorder>();
+    if (recorder.enabled()) recorder.complete(m_name, m_category, m_start);
+  }
+
+ private:
+  std::string m_name;
+  const char* m_category;
+  double m_start;
+};
+
+/**
+ * Calls wait_and_throw() on waitable, a queue or an event, recording the
+ * blocked time for `--trace`.
+ */
+template <typename waitableT>
+void traced_wait_and_throw(waitableT& waitable) {
+  trace_span span("wait_and_throw", "wait");
+  waitable.wait_and_throw();
+}
+
+/**
+ * Constructs a host_accessor from args, recording the time spent waiting for
+ * the accessed buffer for `--trace`.
+ */
+template <typename... argsT>
+auto traced_host_accessor(argsT&&... args) {
+  trace_span span("host_accessor", "wait");
+  return sycl::host_accessor(std::forward<argsT>(args)...);
+}
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_TRACE_RECORDER_H
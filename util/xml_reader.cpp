@@ -0,0 +1,206 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#include "xml_reader.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace sycl_cts {
+namespace util {
+
+namespace {
+
+bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::string trim(const std::string& text) {
+  size_t begin = 0;
+  size_t end = text.size();
+  while (begin < end && is_space(text[begin])) ++begin;
+  while (end > begin && is_space(text[end - 1])) --end;
+  return text.substr(begin, end - begin);
+}
+
+void append_utf8(std::string& out, uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    out += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    out += static_cast<char>(0xC0 | (codePoint >> 6));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    out += static_cast<char>(0xE0 | (codePoint >> 12));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (codePoint >> 18));
+    out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+/** Replaces the character references in text, unknown ones are kept as they
+ *  are */
+std::string decode(const std::string& text) {
+  std::string out;
+  out.reserve(text.size());
+  for (size_t i = 0; i < text.size(); ++i) {
+    const auto end = text[i] == '&' ? text.find(';', i) : std::string::npos;
+    if (end == std::string::npos) {
+      out += text[i];
+      continue;
+    }
+    const auto entity = text.substr(i + 1, end - i - 1);
+    if (entity == "lt") {
+      out += '<';
+    } else if (entity == "gt") {
+      out += '>';
+    } else if (entity == "amp") {
+      out += '&';
+    } else if (entity == "quot") {
+      out += '"';
+    } else if (entity == "apos") {
+      out += '\'';
+    } else if (entity.size() > 1 && entity[0] == '#') {
+      const bool hex = entity[1] == 'x' || entity[1] == 'X';
+      append_utf8(out, static_cast<uint32_t>(std::strtoul(
+                           entity.c_str() + (hex ? 2 : 1), nullptr,
+                           hex ? 16 : 10)));
+    } else {
+      out += text[i];
+      continue;
+    }
+    i = end;
+  }
+  return out;
+}
+
+}  // namespace
+
+std::string xml_element::attribute(const std::string& attributeName,
+                                   const std::string& fallback) const {
+  const auto it = attributes.find(attributeName);
+  return it != attributes.end() ? it->second : fallback;
+}
+
+const xml_element* xml_element::child(const std::string& childName) const {
+  for (const auto& c : children) {
+    if (c.name == childName) return &c;
+  }
+  return nullptr;
+}
+
+xml_element read_xml(const std::string& document) {
+  xml_element root;
+  // Elements that are still open, the innermost last
+  std::vector<xml_element*> open{&root};
+  std::vector<std::string> rawText{""};
+
+  const auto finish = [&] {
+    open.back()->text = trim(decode(rawText.back()));
+    open.pop_back();
+    rawText.pop_back();
+  };
+
+  size_t pos = 0;
+  while (pos < document.size()) {
+    if (document[pos] != '<') {
+      const auto next = document.find('<', pos);
+      const auto end = next == std::string::npos ? document.size() : next;
+      rawText.back() += document.substr(pos, end - pos);
+      pos = end;
+      continue;
+    }
+    if (document.compare(pos, 4, "<!--") == 0) {
+      const auto end = document.find("-->", pos);
+      if (end == std::string::npos) break;
+      pos = end + 3;
+      continue;
+    }
+    if (document.compare(pos, 2, "<?") == 0 ||
+        document.compare(pos, 2, "<!") == 0) {
+      const auto end = document.find('>', pos);
+      if (end == std::string::npos) break;
+      pos = end + 1;
+      continue;
+    }
+    if (document.compare(pos, 2, "</") == 0) {
+      const auto end = document.find('>', pos);
+      if (end == std::string::npos || open.size() == 1) break;
+      open.back()->complete = true;
+      finish();
+      pos = end + 1;
+      continue;
+    }
+
+    // Start tag, Catch2 does not escape '>' in attribute values
+    size_t end = pos + 1;
+    for (char quote = 0; end < document.size(); ++end) {
+      const char c = document[end];
+      if (quote != 0) {
+        if (c == quote) quote = 0;
+      } else if (c == '"' || c == '\'') {
+        quote = c;
+      } else if (c == '>') {
+        break;
+      }
+    }
+    if (end >= document.size()) break;
+    const bool selfClosing = document[end - 1] == '/';
+    const auto tag =
+        document.substr(pos + 1, end - pos - 1 - (selfClosing ? 1 : 0));
+    xml_element element;
+    size_t i = 0;
+    while (i < tag.size() && !is_space(tag[i])) ++i;
+    element.name = tag.substr(0, i);
+    while (i < tag.size()) {
+      while (i < tag.size() && is_space(tag[i])) ++i;
+      const auto equals = tag.find('=', i);
+      if (equals == std::string::npos) break;
+      const auto name = trim(tag.substr(i, equals - i));
+      const auto openQuote = tag.find_first_of("\"'", equals);
+      if (openQuote == std::string::npos) break;
+      const auto closeQuote = tag.find(tag[openQuote], openQuote + 1);
+      if (closeQuote == std::string::npos) break;
+      element.attributes[name] =
+          decode(tag.substr(openQuote + 1, closeQuote - openQuote - 1));
+      i = closeQuote + 1;
+    }
+    element.complete = selfClosing;
+    auto& children = open.back()->children;
+    children.push_back(std::move(element));
+    if (!selfClosing) {
+      open.push_back(&children.back());
+      rawText.emplace_back();
+    }
+    pos = end + 1;
+  }
+  // Keep the text read so far of the elements left open by a truncated
+  // document
+  while (open.size() > 1) finish();
+
+  if (root.children.empty()) return xml_element{};
+  return std::move(root.children.front());
+}
+
+}  // namespace util
+}  // namespace sycl_cts
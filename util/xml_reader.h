@@ -0,0 +1,69 @@
+/*******************************************************************************
+//
+//  SYCL 2020 Conformance Test Suite
+//
+//  Copyright (c) 2023 The Khronos Group Inc.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+*******************************************************************************/
+
+#ifndef __SYCLCTS_UTIL_XML_READER_H
+#define __SYCLCTS_UTIL_XML_READER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sycl_cts {
+namespace util {
+
+/**
+ * Element of a document read by read_xml().
+ */
+struct xml_element {
+  std::string name;
+  std::map<std::string, std::string> attributes;
+  /** Character data of the element, with leading and trailing whitespace
+   *  removed */
+  std::string text;
+  std::vector<xml_element> children;
+  /** Whether the end tag of the element was read */
+  bool complete = false;
+
+  /** Returns the attribute with the given name, or fallback if there is none
+   */
+  std::string attribute(const std::string& attributeName,
+                        const std::string& fallback = "") const;
+
+  /** Returns the first child with the given name, or nullptr if there is none
+   */
+  const xml_element* child(const std::string& childName) const;
+};
+
+/**
+ * Reads the XML document written by the Catch2 XML reporter.
+ *
+ * Only elements, attributes, character data and the predefined and numeric
+ * character references are supported; the declaration, comments and
+ * processing instructions are skipped. A document that ends early, for
+ * example because the process writing it crashed, is read up to that point,
+ * leaving the unfinished elements with `complete` unset.
+ * @return The root element, unnamed if the document contains no element
+ */
+xml_element read_xml(const std::string& document);
+
+}  // namespace util
+}  // namespace sycl_cts
+
+#endif  // __SYCLCTS_UTIL_XML_READER_H